@@ -0,0 +1,108 @@
+// AsyncSemaphore example: many coroutine "sessions" share one FreeRTOS task
+// and one protocol resource. Build with -std=gnu++20.
+//
+// The executor is a FreeRTOS queue of coroutine handles drained by a single
+// task; AsyncSemaphore resumes waiting sessions through it.
+#include <Arduino.h>
+#include <freertos/queue.h>
+#include "AsyncSemaphore.h"
+
+#ifdef SEMAPHORE_GUARD_HAS_COROUTINES
+
+class QueueExecutor : public AsyncExecutor {
+public:
+    explicit QueueExecutor(UBaseType_t depth)
+        : m_queue(xQueueCreate(depth, sizeof(void*))) {}
+
+    void post(std::coroutine_handle<> handle) override {
+        void* address = handle.address();
+        xQueueSend(m_queue, &address, portMAX_DELAY);
+    }
+
+    // Resume queued coroutines forever; run this on the executor task
+    void run() {
+        void* address = nullptr;
+        while (xQueueReceive(m_queue, &address, portMAX_DELAY) == pdTRUE) {
+            std::coroutine_handle<>::from_address(address).resume();
+        }
+    }
+
+private:
+    QueueHandle_t m_queue;
+};
+
+// Minimal fire-and-forget coroutine type
+struct Session {
+    struct promise_type {
+        Session get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+
+// Awaitable that re-queues the coroutine, used to simulate I/O waits
+struct Reschedule {
+    QueueExecutor& executor;
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> handle) { executor.post(handle); }
+    void await_resume() const noexcept {}
+};
+
+// Deep enough for every session to be queued at once, so post() from the
+// executor task itself can never block on a full queue
+static QueueExecutor gExecutor(128);
+static AsyncSemaphore gBus(gExecutor);
+static uint32_t gTransfers = 0;
+static uint32_t gTimeouts = 0;
+
+static Session runSession(int id) {
+    for (int i = 0; i < 10; i++) {
+        AsyncSemaphore::Guard bus = co_await gBus.lockFor(pdMS_TO_TICKS(20));
+        if (!bus.hasLock()) {
+            gTimeouts++;
+            continue;
+        }
+
+        // Hold the bus across a suspension; other sessions keep running
+        co_await Reschedule{gExecutor};
+        gTransfers++;
+    }
+    Serial.printf("Session %d finished\n", id);
+}
+
+static void executorTask(void*) {
+    // Start sessions on the executor task itself
+    for (int id = 0; id < 100; id++) {
+        runSession(id);
+    }
+    gExecutor.run();
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== AsyncSemaphore example ===");
+    xTaskCreatePinnedToCore(executorTask, "executor", 8192, nullptr, 2, nullptr, 1);
+}
+
+void loop() {
+    delay(2000);
+    Serial.printf("transfers=%lu timeouts=%lu free permits=%lu\n",
+                  (unsigned long)gTransfers, (unsigned long)gTimeouts,
+                  (unsigned long)gBus.available());
+}
+
+#else
+
+void setup() {
+    Serial.begin(115200);
+    Serial.println("AsyncSemaphore requires C++20 coroutines (-std=gnu++20)");
+}
+
+void loop() {
+    delay(1000);
+}
+
+#endif
@@ -0,0 +1,84 @@
+// Throughput and fairness of BatchingGuard against a guard per update.
+//
+// A producer task applies 8-byte counter updates under xDataMutex, first
+// with SEMAPHORE_GUARD() around every update, then with one BatchingGuard
+// across all of them. A reader task on the other core takes the same mutex
+// every millisecond and records its longest wait, so the cost of batching
+// shows up next to the saved kernel calls.
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <stdio.h>
+#include "SemaphoreGuard.h"
+#include "BatchingGuard.h"
+
+static constexpr uint32_t kUpdates = 200000;
+static constexpr uint32_t kCounters = 16;
+
+static SemaphoreHandle_t xDataMutex = nullptr;
+static uint64_t gCounters[kCounters];
+static volatile uint32_t gReaderMaxWaitUs = 0;
+static volatile bool gReaderRun = false;
+
+static void readerTask(void*) {
+    while (true) {
+        if (gReaderRun) {
+            const int64_t start = esp_timer_get_time();
+            SemaphoreGuard guard(xDataMutex);
+            const uint32_t waited = (uint32_t)(esp_timer_get_time() - start);
+            if (waited > gReaderMaxWaitUs) {
+                gReaderMaxWaitUs = waited;
+            }
+        }
+        vTaskDelay(1);
+    }
+}
+
+static void report(const char* name, uint32_t cycles, uint32_t handoffs) {
+    Serial.printf("%-28s %5lu cycles per update, %6lu lock handoffs, reader max wait %5lu us\n",
+                  name, (unsigned long)(cycles / kUpdates), (unsigned long)handoffs,
+                  (unsigned long)gReaderMaxWaitUs);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== BatchingGuard benchmark ===");
+
+    xDataMutex = xSemaphoreCreateMutex();
+    if (!xDataMutex) {
+        Serial.println("Failed to create mutex!");
+        return;
+    }
+    xTaskCreatePinnedToCore(readerTask, "reader", 4096, nullptr, 2, nullptr, 0);
+
+    gReaderMaxWaitUs = 0;
+    gReaderRun = true;
+    uint32_t start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < kUpdates; i++) {
+        SEMAPHORE_GUARD(xDataMutex);
+        gCounters[i % kCounters] += i;
+    }
+    report("SEMAPHORE_GUARD per update", ESP.getCycleCount() - start, kUpdates);
+
+    const uint32_t batchSizes[] = {16, 64, 256};
+    for (uint32_t maxOps : batchSizes) {
+        gReaderMaxWaitUs = 0;
+        start = ESP.getCycleCount();
+        uint32_t handoffs;
+        {
+            BatchingGuard batch(xDataMutex, maxOps, pdMS_TO_TICKS(1));
+            for (uint32_t i = 0; i < kUpdates && batch.next(); i++) {
+                gCounters[i % kCounters] += i;
+            }
+            handoffs = batch.handoffs();
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "BatchingGuard, %lu ops", (unsigned long)maxOps);
+        report(name, ESP.getCycleCount() - start, handoffs);
+    }
+    gReaderRun = false;
+}
+
+void loop() {
+    delay(1000);
+}
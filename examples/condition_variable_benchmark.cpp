@@ -0,0 +1,125 @@
+// Wake-up latency benchmark: ConditionVariable versus polling shared state
+// under SEMAPHORE_GUARD() with vTaskDelay() in between.
+//
+// A producer on core 0 publishes an event every 20 ms and records the cycle
+// count; a consumer on core 1 notes how long it took to see the event.
+// Polling latency is bounded by the poll period and costs CPU even when
+// idle; the condition variable wakes the consumer directly.
+#include <Arduino.h>
+#include "SemaphoreGuard.h"
+#include "ConditionVariable.h"
+
+enum class Mode { Polling, Condition, Stopped };
+
+static constexpr uint32_t kPollMs = 10;
+static constexpr int kEvents = 200;
+
+static volatile Mode gMode = Mode::Stopped;
+static SemaphoreHandle_t xStateMutex = nullptr;
+static ConditionVariable gEventReady;
+
+// Protected by xStateMutex
+static uint32_t gPublished = 0;
+static uint32_t gPublishCycles = 0;
+
+static volatile uint32_t gSeen = 0;
+static volatile uint32_t gMaxLatency = 0;
+static volatile uint64_t gTotalLatency = 0;
+static volatile uint32_t gPolls = 0;
+
+static void recordLatency(uint32_t publishCycles) {
+    const uint32_t latency = ESP.getCycleCount() - publishCycles;
+    if (latency > gMaxLatency) {
+        gMaxLatency = latency;
+    }
+    gTotalLatency = gTotalLatency + latency;
+    gSeen = gSeen + 1;
+}
+
+static void consumerTask(void*) {
+    uint32_t consumed = 0;
+    while (true) {
+        const Mode mode = gMode;
+        if (mode == Mode::Polling) {
+            bool ready = false;
+            uint32_t publishCycles = 0;
+            {
+                SEMAPHORE_GUARD(xStateMutex);
+                ready = gPublished != consumed;
+                if (ready) {
+                    consumed = gPublished;
+                    publishCycles = gPublishCycles;
+                }
+            }
+            gPolls = gPolls + 1;
+            if (ready) {
+                recordLatency(publishCycles);
+            } else {
+                vTaskDelay(pdMS_TO_TICKS(kPollMs));
+            }
+        } else if (mode == Mode::Condition) {
+            SEMAPHORE_GUARD(xStateMutex);
+            // Time out now and then so a mode change is noticed
+            if (gEventReady.waitFor(guard, pdMS_TO_TICKS(100), [&] { return gPublished != consumed; })) {
+                consumed = gPublished;
+                recordLatency(gPublishCycles);
+            }
+        } else {
+            SEMAPHORE_GUARD(xStateMutex);
+            consumed = gPublished;
+            vTaskDelay(1);
+        }
+    }
+}
+
+static void runPhase(Mode mode, const char* name) {
+    gSeen = 0;
+    gMaxLatency = 0;
+    gTotalLatency = 0;
+    gPolls = 0;
+    gMode = mode;
+    delay(50);
+
+    for (int i = 0; i < kEvents; i++) {
+        delay(20);
+        {
+            SEMAPHORE_GUARD(xStateMutex);
+            gPublished++;
+            gPublishCycles = ESP.getCycleCount();
+        }
+        gEventReady.notifyOne();
+    }
+    delay(50);
+    gMode = Mode::Stopped;
+    delay(150);
+
+    const uint32_t mhz = ESP.getCpuFreqMHz();
+    const uint32_t seen = gSeen > 0 ? gSeen : 1;
+    Serial.printf("%-10s events=%lu  avg=%lu us  max=%lu us  lock polls=%lu\n",
+                  name,
+                  (unsigned long)gSeen,
+                  (unsigned long)(gTotalLatency / seen / mhz),
+                  (unsigned long)(gMaxLatency / mhz),
+                  (unsigned long)gPolls);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== ConditionVariable wake-up latency benchmark ===");
+
+    xStateMutex = xSemaphoreCreateMutex();
+    if (!xStateMutex) {
+        Serial.println("Failed to create mutex!");
+        return;
+    }
+
+    xTaskCreatePinnedToCore(consumerTask, "consumer", 4096, nullptr, 3, nullptr, 1);
+
+    runPhase(Mode::Polling, "polling");
+    runPhase(Mode::Condition, "condvar");
+}
+
+void loop() {
+    delay(1000);
+}
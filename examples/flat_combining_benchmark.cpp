@@ -0,0 +1,101 @@
+// Throughput benchmark: FlatCombiner versus plain SemaphoreGuard on a
+// contended statistics mutex, with 2 to 8 contending tasks.
+//
+// Every task performs kOpsPerTask short statistics updates as fast as it
+// can. The sketch reports total updates per second for both variants.
+#include <Arduino.h>
+#include "SemaphoreGuard.h"
+#include "FlatCombiner.h"
+
+struct Statistics {
+    uint32_t samples;
+    uint32_t sum;
+    uint32_t min;
+    uint32_t max;
+};
+
+static constexpr uint32_t kOpsPerTask = 20000;
+
+static SemaphoreHandle_t xStatsMutex = nullptr;
+static Statistics gStats;
+static FlatCombiner<8> gCombiner;
+static SemaphoreHandle_t xDone = nullptr;
+static volatile bool gUseCombiner = false;
+
+static void addSample(void* arg) {
+    const uint32_t value = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(arg));
+    gStats.samples++;
+    gStats.sum += value;
+    if (value < gStats.min) {
+        gStats.min = value;
+    }
+    if (value > gStats.max) {
+        gStats.max = value;
+    }
+}
+
+static void contenderTask(void*) {
+    for (uint32_t i = 0; i < kOpsPerTask; i++) {
+        void* sample = reinterpret_cast<void*>(static_cast<uintptr_t>(i & 0xFF));
+        if (gUseCombiner) {
+            gCombiner.execute(addSample, sample);
+        } else {
+            SemaphoreGuard guard(xStatsMutex);
+            addSample(sample);
+        }
+    }
+    gCombiner.detach();
+    xSemaphoreGive(xDone);
+    vTaskDelete(nullptr);
+}
+
+static uint32_t runPhase(int tasks, bool useCombiner) {
+    gStats = Statistics{0, 0, UINT32_MAX, 0};
+    gUseCombiner = useCombiner;
+
+    const int64_t start = esp_timer_get_time();
+    for (int i = 0; i < tasks; i++) {
+        xTaskCreatePinnedToCore(contenderTask, "contender", 4096, nullptr, 2, nullptr, i % 2);
+    }
+    for (int i = 0; i < tasks; i++) {
+        xSemaphoreTake(xDone, portMAX_DELAY);
+    }
+    const int64_t elapsedUs = esp_timer_get_time() - start;
+
+    if (gStats.samples != tasks * kOpsPerTask) {
+        Serial.printf("  lost updates: %lu of %lu\n",
+                      (unsigned long)gStats.samples, (unsigned long)(tasks * kOpsPerTask));
+    }
+    return static_cast<uint32_t>((uint64_t)tasks * kOpsPerTask * 1000000ULL / elapsedUs);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== FlatCombiner vs SemaphoreGuard throughput ===");
+
+    xStatsMutex = xSemaphoreCreateMutex();
+    xDone = xSemaphoreCreateCounting(8, 0);
+    if (!xStatsMutex || !xDone) {
+        Serial.println("Failed to create semaphores!");
+        return;
+    }
+
+    Serial.println("tasks   guard ops/s   combiner ops/s   passes   combined");
+    for (int tasks = 2; tasks <= 8; tasks++) {
+        const uint32_t passesBefore = gCombiner.passes();
+        const uint32_t combinedBefore = gCombiner.combinedOperations();
+
+        const uint32_t guardRate = runPhase(tasks, false);
+        const uint32_t combinerRate = runPhase(tasks, true);
+
+        Serial.printf("%5d   %11lu   %14lu   %6lu   %8lu\n", tasks,
+                      (unsigned long)guardRate, (unsigned long)combinerRate,
+                      (unsigned long)(gCombiner.passes() - passesBefore),
+                      (unsigned long)(gCombiner.combinedOperations() - combinedBefore));
+    }
+}
+
+void loop() {
+    delay(1000);
+}
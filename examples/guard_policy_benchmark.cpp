@@ -0,0 +1,145 @@
+// Overhead benchmark for BasicSemaphoreGuard policy instantiations.
+//
+// Compares an uncontended take/give written by hand, BaselineGuard (the
+// SemaphoreGuard from before the guards were unified, copied below),
+// SemaphoreGuard, RecursiveSemaphoreGuard, a silent guard without logging
+// and a guard with a counting stats policy, and prints sizeof() of each
+// guard type.
+//
+// For code size, both guards' members are out of line; compare
+//     xtensa-esp32-elf-nm --size-sort -C .pio/build/*/firmware.elf | grep Guard
+// for BaselineGuard against BasicSemaphoreGuard<SemaphoreAcquire, ...>.
+#include <Arduino.h>
+#include "SemaphoreGuard.h"
+#include "RecursiveSemaphoreGuard.h"
+
+static constexpr uint32_t kIterations = 100000;
+
+// Stats policy that counts acquisitions; only guards that use it pay for it
+struct CountingStats {
+    static uint32_t s_acquired;
+    void onAcquireStart(SemaphoreHandle_t) {}
+    void onAcquireEnd(SemaphoreHandle_t, bool taken, const GuardSite&) {
+        if (taken) {
+            s_acquired++;
+        }
+    }
+    void onRelease(SemaphoreHandle_t) {}
+};
+uint32_t CountingStats::s_acquired = 0;
+
+// SemaphoreGuard as it was before BasicSemaphoreGuard (release build):
+// every constructor checks and takes on its own
+class BaselineGuard {
+public:
+    explicit BaselineGuard(SemaphoreHandle_t handle);
+    BaselineGuard(SemaphoreHandle_t handle, TickType_t timeout);
+    ~BaselineGuard();
+
+    BaselineGuard(const BaselineGuard&) = delete;
+    BaselineGuard& operator=(const BaselineGuard&) = delete;
+
+    [[nodiscard]] bool hasLock() const noexcept { return m_taken; }
+
+private:
+    SemaphoreHandle_t m_handle;
+    bool m_taken;
+    bool m_deadlineExpired;
+};
+
+// Out of line, as they were in SemaphoreGuard.cpp
+__attribute__((noinline)) BaselineGuard::BaselineGuard(SemaphoreHandle_t handle)
+    : m_handle(handle), m_taken(false), m_deadlineExpired(false) {
+    if (m_handle == nullptr) {
+        SEMG_LOG_E("Null semaphore handle provided");
+        return;
+    }
+    if (xPortInIsrContext()) {
+        SEMG_LOG_E("Cannot use SemaphoreGuard in ISR context");
+        return;
+    }
+    m_taken = (xSemaphoreTake(m_handle, portMAX_DELAY) == pdTRUE);
+}
+
+__attribute__((noinline)) BaselineGuard::BaselineGuard(SemaphoreHandle_t handle, TickType_t timeout)
+    : m_handle(handle), m_taken(false), m_deadlineExpired(false) {
+    if (m_handle == nullptr) {
+        SEMG_LOG_E("Null semaphore handle provided");
+        return;
+    }
+    if (xPortInIsrContext()) {
+        SEMG_LOG_E("Cannot use SemaphoreGuard in ISR context");
+        return;
+    }
+    m_taken = (xSemaphoreTake(m_handle, timeout) == pdTRUE);
+}
+
+__attribute__((noinline)) BaselineGuard::~BaselineGuard() {
+    if (m_taken && m_handle != nullptr) {
+        xSemaphoreGive(m_handle);
+    }
+}
+
+typedef BasicSemaphoreGuard<SemaphoreAcquire, NoTiming, NoStats, NoLog> SilentGuard;
+typedef BasicSemaphoreGuard<SemaphoreAcquire, NoTiming, CountingStats, SemaphoreLog> CountingGuard;
+
+static SemaphoreHandle_t xMutex = nullptr;
+static SemaphoreHandle_t xRecursive = nullptr;
+
+template <typename Body>
+static void measure(const char* name, size_t guardSize, Body body) {
+    const uint32_t start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < kIterations; i++) {
+        body();
+    }
+    const uint32_t cycles = ESP.getCycleCount() - start;
+    Serial.printf("%-16s %4lu cycles per lock/unlock  sizeof=%u\n",
+                  name, (unsigned long)(cycles / kIterations), (unsigned)guardSize);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== Guard policy overhead benchmark ===");
+
+    xMutex = xSemaphoreCreateMutex();
+    xRecursive = xSemaphoreCreateRecursiveMutex();
+    if (!xMutex || !xRecursive) {
+        Serial.println("Failed to create mutexes!");
+        return;
+    }
+
+    measure("hand-written", 0, [] {
+        if (xSemaphoreTake(xMutex, portMAX_DELAY) == pdTRUE) {
+            xSemaphoreGive(xMutex);
+        }
+    });
+    measure("BaselineGuard", sizeof(BaselineGuard), [] {
+        BaselineGuard guard(xMutex);
+    });
+    measure("SemaphoreGuard", sizeof(SemaphoreGuard), [] {
+        SemaphoreGuard guard(xMutex);
+    });
+    measure("Baseline timeout", sizeof(BaselineGuard), [] {
+        BaselineGuard guard(xMutex, 10);
+    });
+    measure("Guard timeout", sizeof(SemaphoreGuard), [] {
+        SemaphoreGuard guard(xMutex, 10);
+    });
+    measure("RecursiveGuard", sizeof(RecursiveSemaphoreGuard), [] {
+        RecursiveSemaphoreGuard guard(xRecursive);
+    });
+    measure("SilentGuard", sizeof(SilentGuard), [] {
+        SilentGuard guard(xMutex);
+    });
+    measure("CountingGuard", sizeof(CountingGuard), [] {
+        CountingGuard guard(xMutex);
+    });
+
+    Serial.printf("CountingStats recorded %lu acquisitions\n",
+                  (unsigned long)CountingStats::s_acquired);
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,78 @@
+// Startup benchmark: 64 module-level mutexes created eagerly in setup()
+// versus 64 LazySemaphore instances of which only a few are ever used.
+//
+// Reports the time spent creating locks at boot and the heap they consume,
+// then the cost of the first and of later acquisitions of a lazy mutex.
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "SemaphoreGuard.h"
+#include "LazySemaphore.h"
+
+static constexpr int kLocks = 64;
+static constexpr int kUsed = 4;
+
+// Eager style: handles filled in by setup()
+static SemaphoreHandle_t gEager[kLocks];
+
+// Lazy style: constant-initialised, no kernel objects until first use
+static LazySemaphore gLazy[kLocks];
+
+static void measureEager() {
+    const size_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    const uint32_t start = ESP.getCycleCount();
+    for (int i = 0; i < kLocks; i++) {
+        gEager[i] = xSemaphoreCreateMutex();
+    }
+    const uint32_t cycles = ESP.getCycleCount() - start;
+    const size_t used = freeBefore - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    Serial.printf("eager  boot=%lu us  heap=%u bytes  (%d locks)\n",
+                  (unsigned long)(cycles / ESP.getCpuFreqMHz()), (unsigned)used, kLocks);
+}
+
+static void measureLazy() {
+    const size_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+    // Only a few modules actually run
+    uint32_t firstCycles = 0;
+    for (int i = 0; i < kUsed; i++) {
+        const uint32_t start = ESP.getCycleCount();
+        {
+            SEMAPHORE_GUARD(gLazy[i]);
+        }
+        firstCycles += ESP.getCycleCount() - start;
+    }
+
+    uint32_t laterCycles = 0;
+    for (int round = 0; round < 100; round++) {
+        const uint32_t start = ESP.getCycleCount();
+        {
+            SEMAPHORE_GUARD(gLazy[0]);
+        }
+        laterCycles += ESP.getCycleCount() - start;
+    }
+
+    const size_t used = freeBefore - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+    int created = 0;
+    for (int i = 0; i < kLocks; i++) {
+        created += gLazy[i].isCreated() ? 1 : 0;
+    }
+
+    Serial.printf("lazy   boot=0 us  heap=%u bytes  (%d of %d locks created, %u bytes of .bss)\n",
+                  (unsigned)used, created, kLocks, (unsigned)sizeof(gLazy));
+    Serial.printf("lazy   first guard=%lu cycles  later guards=%lu cycles\n",
+                  (unsigned long)(firstCycles / kUsed), (unsigned long)(laterCycles / 100));
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== LazySemaphore startup benchmark ===");
+
+    measureEager();
+    measureLazy();
+}
+
+void loop() {
+    delay(1000);
+}
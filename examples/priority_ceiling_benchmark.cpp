@@ -0,0 +1,130 @@
+// Worst-case blocking benchmark: PriorityCeilingGuard versus SemaphoreGuard.
+//
+// A 1 kHz control task (high priority) shares a binary-semaphore lock with a
+// low-priority logger that holds it for about 200 us at a time. A
+// medium-priority CPU hog on the same core wakes every few milliseconds and
+// runs for a while. With SemaphoreGuard the hog can preempt the logger while
+// it holds the lock, so the control task waits for the hog as well
+// (unbounded priority inversion). With PriorityCeilingGuard the logger runs
+// at the ceiling while holding the lock and the control task waits at most
+// one critical section.
+#include <Arduino.h>
+#include "SemaphoreGuard.h"
+#include "PriorityCeilingGuard.h"
+
+enum class Mode { Plain, Ceiling, Stopped };
+
+static constexpr UBaseType_t kLowPriority = 2;
+static constexpr UBaseType_t kMediumPriority = 5;
+static constexpr UBaseType_t kControlPriority = 10;
+static constexpr uint32_t kRunMs = 5000;
+static constexpr BaseType_t kCore = 1;
+
+static volatile Mode gMode = Mode::Stopped;
+static SemaphoreHandle_t xBusLock = nullptr;
+
+static volatile uint32_t gCycles = 0;
+static volatile uint32_t gMaxBlockUs = 0;
+static volatile uint32_t gMissed = 0;
+
+static void busyWaitUs(uint32_t us) {
+    const uint32_t start = micros();
+    while (micros() - start < us) {
+    }
+}
+
+static void controlTask(void*) {
+    TickType_t lastWake = xTaskGetTickCount();
+    while (true) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(1));
+        const Mode mode = gMode;
+        if (mode == Mode::Stopped) {
+            continue;
+        }
+
+        const uint32_t start = micros();
+        if (mode == Mode::Plain) {
+            SEMAPHORE_GUARD(xBusLock);
+            const uint32_t blocked = micros() - start;
+            if (blocked > gMaxBlockUs) {
+                gMaxBlockUs = blocked;
+            }
+            busyWaitUs(20);
+        } else {
+            PriorityCeilingGuard guard(xBusLock, kControlPriority);
+            const uint32_t blocked = micros() - start;
+            if (blocked > gMaxBlockUs) {
+                gMaxBlockUs = blocked;
+            }
+            busyWaitUs(20);
+        }
+        if (micros() - start > 1000) {
+            gMissed = gMissed + 1;
+        }
+        gCycles = gCycles + 1;
+    }
+}
+
+static void loggerTask(void*) {
+    while (true) {
+        const Mode mode = gMode;
+        if (mode == Mode::Plain) {
+            SEMAPHORE_GUARD(xBusLock);
+            busyWaitUs(200);
+        } else if (mode == Mode::Ceiling) {
+            PriorityCeilingGuard guard(xBusLock, kControlPriority);
+            busyWaitUs(200);
+        }
+        vTaskDelay(1);
+    }
+}
+
+static void hogTask(void*) {
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(3));
+        if (gMode != Mode::Stopped) {
+            busyWaitUs(2000);
+        }
+    }
+}
+
+static void runPhase(Mode mode, const char* name) {
+    gCycles = 0;
+    gMaxBlockUs = 0;
+    gMissed = 0;
+    gMode = mode;
+    delay(kRunMs);
+    gMode = Mode::Stopped;
+    delay(50);
+
+    Serial.printf("%-22s %6lu cycles  worst blocking=%5lu us  missed deadlines=%lu\n",
+                  name,
+                  (unsigned long)gCycles,
+                  (unsigned long)gMaxBlockUs,
+                  (unsigned long)gMissed);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== Priority ceiling blocking benchmark ===");
+
+    // Binary semaphore: no priority inheritance to help the plain guard
+    xBusLock = xSemaphoreCreateBinary();
+    if (!xBusLock) {
+        Serial.println("Failed to create semaphore!");
+        return;
+    }
+    xSemaphoreGive(xBusLock);
+
+    xTaskCreatePinnedToCore(controlTask, "control", 4096, nullptr, kControlPriority, nullptr, kCore);
+    xTaskCreatePinnedToCore(hogTask, "hog", 4096, nullptr, kMediumPriority, nullptr, kCore);
+    xTaskCreatePinnedToCore(loggerTask, "logger", 4096, nullptr, kLowPriority, nullptr, kCore);
+
+    runPhase(Mode::Plain, "SemaphoreGuard");
+    runPhase(Mode::Ceiling, "PriorityCeilingGuard");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,133 @@
+// Reader latency benchmark: RcuStore<T> versus SemaphoreGuard for a
+// read-mostly configuration block, with reader tasks pinned to both cores.
+//
+// A writer publishes a new configuration every 100 ms (far more often than
+// in production) so the grace-period path is exercised during the run.
+#include <Arduino.h>
+#include "SemaphoreGuard.h"
+#include "RcuStore.h"
+
+struct Config {
+    uint32_t version;
+    uint32_t sampleRateHz;
+    uint32_t timeoutMs;
+    char hostname[32];
+};
+
+enum class Mode { Mutex, Rcu, Stopped };
+
+static constexpr uint32_t kRunMs = 5000;
+
+static volatile Mode gMode = Mode::Stopped;
+static SemaphoreHandle_t xConfigMutex = nullptr;
+static Config gMutexConfig = {};
+static RcuStore<Config> gRcuConfig;
+
+struct ReaderStats {
+    uint32_t reads;
+    uint32_t maxCycles;
+    uint64_t totalCycles;
+};
+static ReaderStats gStats[portNUM_PROCESSORS];
+
+static void readerTask(void* param) {
+    const int core = static_cast<int>(reinterpret_cast<intptr_t>(param));
+    volatile uint32_t sink = 0;
+    while (true) {
+        const Mode mode = gMode;
+        if (mode == Mode::Stopped) {
+            vTaskDelay(1);
+            continue;
+        }
+
+        const uint32_t start = ESP.getCycleCount();
+        if (mode == Mode::Mutex) {
+            SemaphoreGuard guard(xConfigMutex);
+            sink = gMutexConfig.sampleRateHz + gMutexConfig.timeoutMs;
+        } else {
+            RcuStore<Config>::ReadGuard config(gRcuConfig);
+            sink = config->sampleRateHz + config->timeoutMs;
+        }
+        const uint32_t cycles = ESP.getCycleCount() - start;
+
+        ReaderStats& stats = gStats[core];
+        stats.reads++;
+        stats.totalCycles += cycles;
+        if (cycles > stats.maxCycles) {
+            stats.maxCycles = cycles;
+        }
+
+        // Let the idle task feed the watchdog now and then
+        if ((stats.reads & 0x3FF) == 0) {
+            vTaskDelay(1);
+        }
+    }
+    (void)sink;
+}
+
+static void writerTask(void*) {
+    uint32_t version = 0;
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(100));
+        const Mode mode = gMode;
+        version++;
+        if (mode == Mode::Mutex) {
+            SemaphoreGuard guard(xConfigMutex);
+            gMutexConfig.version = version;
+            gMutexConfig.sampleRateHz = 100 + (version % 10);
+        } else if (mode == Mode::Rcu) {
+            gRcuConfig.modify([version](Config& config) {
+                config.version = version;
+                config.sampleRateHz = 100 + (version % 10);
+            });
+        }
+    }
+}
+
+static void runPhase(Mode mode, const char* name) {
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        gStats[core] = ReaderStats{};
+    }
+
+    gMode = mode;
+    delay(kRunMs);
+    gMode = Mode::Stopped;
+    delay(50);
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        const ReaderStats& stats = gStats[core];
+        const uint32_t avg = stats.reads ? (uint32_t)(stats.totalCycles / stats.reads) : 0;
+        Serial.printf("%-6s core %d: reads=%lu  avg=%lu cycles  max=%lu cycles\n",
+                      name, core,
+                      (unsigned long)stats.reads,
+                      (unsigned long)avg,
+                      (unsigned long)stats.maxCycles);
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== RcuStore vs SemaphoreGuard reader latency ===");
+    Serial.printf("RcuStore<Config> storage: %u bytes\n", (unsigned)RcuStore<Config>::storageBytes());
+
+    xConfigMutex = xSemaphoreCreateMutex();
+    if (!xConfigMutex) {
+        Serial.println("Failed to create mutex!");
+        return;
+    }
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        xTaskCreatePinnedToCore(readerTask, "reader", 4096,
+                                reinterpret_cast<void*>(static_cast<intptr_t>(core)),
+                                1, nullptr, core);
+    }
+    xTaskCreatePinnedToCore(writerTask, "writer", 4096, nullptr, 2, nullptr, 0);
+
+    runPhase(Mode::Mutex, "mutex");
+    runPhase(Mode::Rcu, "rcu");
+}
+
+void loop() {
+    delay(1000);
+}
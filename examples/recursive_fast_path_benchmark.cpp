@@ -0,0 +1,78 @@
+// Nested acquisition cost of RecursiveSemaphoreGuard against nesting depth.
+//
+// Each iteration takes one recursive mutex depth times, nested, and
+// releases it again. The raw rows use xSemaphoreTakeRecursive() and
+// xSemaphoreGiveRecursive() at every level; the guard rows use
+// RecursiveSemaphoreGuard. Build once as is and once with
+// -DSEMAPHORE_GUARD_RECURSIVE_FAST_PATH: with the fast path, only the
+// outermost guard reaches the kernel and each further level costs a few
+// cycles instead of a full take/give. The recursion statistics collected
+// on the way are printed at the end.
+#include <Arduino.h>
+#include "RecursiveSemaphoreGuard.h"
+#include "RecursiveOwnership.h"
+
+static constexpr uint32_t kIterations = 10000;
+static constexpr int kMaxDepth = 10;
+
+static SemaphoreHandle_t xRecursiveMutex = nullptr;
+
+static void rawNested(int depth) {
+    xSemaphoreTakeRecursive(xRecursiveMutex, portMAX_DELAY);
+    if (depth > 1) {
+        rawNested(depth - 1);
+    }
+    xSemaphoreGiveRecursive(xRecursiveMutex);
+}
+
+static void guardNested(int depth) {
+    RecursiveSemaphoreGuard guard(xRecursiveMutex);
+    if (depth > 1) {
+        guardNested(depth - 1);
+    }
+}
+
+static uint32_t measure(void (*nested)(int), int depth) {
+    const uint32_t start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < kIterations; i++) {
+        nested(depth);
+    }
+    return (ESP.getCycleCount() - start) / kIterations;
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== Recursive mutex nesting benchmark ===");
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+    Serial.println("Fast path: on");
+#else
+    Serial.println("Fast path: off (build with -DSEMAPHORE_GUARD_RECURSIVE_FAST_PATH)");
+#endif
+
+    xRecursiveMutex = xSemaphoreCreateRecursiveMutex();
+    if (!xRecursiveMutex) {
+        Serial.println("Failed to create recursive mutex!");
+        return;
+    }
+
+    Serial.println("depth   raw cycles   guard cycles   guard per extra level");
+    uint32_t guardBase = 0;
+    for (int depth = 1; depth <= kMaxDepth; depth++) {
+        const uint32_t raw = measure(rawNested, depth);
+        const uint32_t guard = measure(guardNested, depth);
+        if (depth == 1) {
+            guardBase = guard;
+            Serial.printf("%5d   %10lu   %12lu\n", depth, (unsigned long)raw, (unsigned long)guard);
+        } else {
+            Serial.printf("%5d   %10lu   %12lu   %21lu\n", depth, (unsigned long)raw, (unsigned long)guard,
+                          (unsigned long)((guard - guardBase) / (depth - 1)));
+        }
+    }
+
+    RecursiveOwnership::report();
+}
+
+void loop() {
+    delay(1000);
+}
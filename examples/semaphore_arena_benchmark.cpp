@@ -0,0 +1,108 @@
+// Creation benchmark: xSemaphoreCreateMutex() versus SemaphoreArena.
+//
+// Creates and deletes a batch of mutexes repeatedly with each method and
+// reports the average create/delete cost, the heap consumed while the batch
+// is alive and the largest free heap block afterwards (fragmentation).
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+#include "SemaphoreGuard.h"
+#include "SemaphoreArena.h"
+
+static constexpr size_t kBatch = 32;
+static constexpr int kRounds = 100;
+
+static SemaphoreArena<kBatch> gArena;
+
+static void reportPhase(const char* name, uint32_t createCycles, uint32_t deleteCycles,
+                        size_t heapUsed) {
+    const uint32_t mhz = ESP.getCpuFreqMHz();
+    const uint32_t ops = kBatch * kRounds;
+    Serial.printf("%-6s create=%lu cycles (%lu ns)  delete=%lu cycles  heap used by batch=%u bytes  "
+                  "largest free block=%u bytes\n",
+                  name,
+                  (unsigned long)(createCycles / ops),
+                  (unsigned long)(createCycles / ops * 1000 / mhz),
+                  (unsigned long)(deleteCycles / ops),
+                  (unsigned)heapUsed,
+                  (unsigned)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
+}
+
+static void runHeap() {
+    SemaphoreHandle_t handles[kBatch];
+    uint32_t createCycles = 0;
+    uint32_t deleteCycles = 0;
+    size_t heapUsed = 0;
+
+    for (int round = 0; round < kRounds; round++) {
+        const size_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+        uint32_t start = ESP.getCycleCount();
+        for (size_t i = 0; i < kBatch; i++) {
+            handles[i] = xSemaphoreCreateMutex();
+        }
+        createCycles += ESP.getCycleCount() - start;
+
+        heapUsed = freeBefore - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+        // Use each mutex once so neither variant is optimised away
+        for (size_t i = 0; i < kBatch; i++) {
+            SEMAPHORE_GUARD(handles[i]);
+        }
+
+        start = ESP.getCycleCount();
+        for (size_t i = 0; i < kBatch; i++) {
+            vSemaphoreDelete(handles[i]);
+        }
+        deleteCycles += ESP.getCycleCount() - start;
+    }
+    reportPhase("heap", createCycles, deleteCycles, heapUsed);
+}
+
+static void runArena() {
+    ArenaSemaphore handles[kBatch];
+    uint32_t createCycles = 0;
+    uint32_t deleteCycles = 0;
+    size_t heapUsed = 0;
+
+    for (int round = 0; round < kRounds; round++) {
+        const size_t freeBefore = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+        uint32_t start = ESP.getCycleCount();
+        for (size_t i = 0; i < kBatch; i++) {
+            handles[i] = gArena.createMutex();
+        }
+        createCycles += ESP.getCycleCount() - start;
+
+        heapUsed = freeBefore - heap_caps_get_free_size(MALLOC_CAP_8BIT);
+
+        for (size_t i = 0; i < kBatch; i++) {
+            SEMAPHORE_GUARD(handles[i]);
+        }
+
+        start = ESP.getCycleCount();
+        for (size_t i = 0; i < kBatch; i++) {
+            handles[i].reset();
+        }
+        deleteCycles += ESP.getCycleCount() - start;
+    }
+    reportPhase("arena", createCycles, deleteCycles, heapUsed);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== Semaphore creation benchmark ===");
+
+    runHeap();
+    runArena();
+    gArena.logStats();
+
+    const SemaphoreArenaStats stats = gArena.getStats();
+    Serial.printf("Arena: %u slots, high water %u, %u bytes of static RAM\n",
+                  (unsigned)stats.capacity, (unsigned)stats.highWater,
+                  (unsigned)stats.storageBytes);
+}
+
+void loop() {
+    delay(1000);
+}
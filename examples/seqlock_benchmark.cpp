@@ -0,0 +1,149 @@
+// Contention benchmark: SeqLock<T> versus SEMAPHORE_GUARD() for a 64-byte
+// sensor snapshot written at 1 kHz and read by five consumer tasks.
+//
+// For each variant the sketch reports the writer's worst-case update time
+// (the number that matters for the 1 kHz loop) and the reader throughput.
+#include <Arduino.h>
+#include "SemaphoreGuard.h"
+#include "SeqLock.h"
+
+struct ImuState {
+    uint32_t timestamp;
+    float accel[3];
+    float gyro[3];
+    float mag[3];
+    float quaternion[4];
+    uint32_t flags;
+    uint32_t reserved;
+};
+static_assert(sizeof(ImuState) == 64, "benchmark expects a 64-byte snapshot");
+
+enum class Mode { Mutex, SeqLock, Stopped };
+
+static constexpr int kReaders = 5;
+static constexpr uint32_t kRunMs = 5000;
+
+static volatile Mode gMode = Mode::Stopped;
+static SemaphoreHandle_t xDataMutex = nullptr;
+static ImuState gMutexState;
+static SeqLock<ImuState> gSeqState;
+
+static volatile uint32_t gWriterMaxCycles = 0;
+static volatile uint32_t gWrites = 0;
+static volatile uint32_t gReads[kReaders];
+static volatile uint32_t gTorn = 0;
+
+static void writerTask(void*) {
+    TickType_t lastWake = xTaskGetTickCount();
+    ImuState next = {};
+    while (true) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(1));
+        const Mode mode = gMode;
+        if (mode == Mode::Stopped) {
+            continue;
+        }
+
+        next.timestamp++;
+        for (int i = 0; i < 4; i++) {
+            next.quaternion[i] = static_cast<float>(next.timestamp);
+        }
+
+        const uint32_t start = ESP.getCycleCount();
+        if (mode == Mode::Mutex) {
+            SEMAPHORE_GUARD(xDataMutex);
+            gMutexState = next;
+        } else {
+            gSeqState.write(next);
+        }
+        const uint32_t cycles = ESP.getCycleCount() - start;
+
+        if (cycles > gWriterMaxCycles) {
+            gWriterMaxCycles = cycles;
+        }
+        gWrites = gWrites + 1;
+    }
+}
+
+static void readerTask(void* param) {
+    const int id = static_cast<int>(reinterpret_cast<intptr_t>(param));
+    ImuState copy;
+    while (true) {
+        const Mode mode = gMode;
+        if (mode == Mode::Stopped) {
+            vTaskDelay(1);
+            continue;
+        }
+
+        if (mode == Mode::Mutex) {
+            SEMAPHORE_GUARD(xDataMutex);
+            copy = gMutexState;
+            // Simulate a slow consumer holding the lock while it processes
+            delayMicroseconds(50);
+        } else {
+            copy = gSeqState.read();
+            delayMicroseconds(50);
+        }
+
+        // All quaternion components are written with the same value
+        if (copy.quaternion[0] != copy.quaternion[3]) {
+            gTorn = gTorn + 1;
+        }
+        gReads[id] = gReads[id] + 1;
+        taskYIELD();
+    }
+}
+
+static void runPhase(Mode mode, const char* name) {
+    gWriterMaxCycles = 0;
+    gWrites = 0;
+    gTorn = 0;
+    for (int i = 0; i < kReaders; i++) {
+        gReads[i] = 0;
+    }
+
+    gMode = mode;
+    delay(kRunMs);
+    gMode = Mode::Stopped;
+    delay(50);
+
+    uint32_t totalReads = 0;
+    for (int i = 0; i < kReaders; i++) {
+        totalReads += gReads[i];
+    }
+
+    const uint32_t mhz = ESP.getCpuFreqMHz();
+    Serial.printf("%-10s writes=%lu  writer max=%lu cycles (%lu us)  reads/s=%lu  torn=%lu\n",
+                  name,
+                  (unsigned long)gWrites,
+                  (unsigned long)gWriterMaxCycles,
+                  (unsigned long)(gWriterMaxCycles / mhz),
+                  (unsigned long)(totalReads * 1000 / kRunMs),
+                  (unsigned long)gTorn);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== SeqLock vs SemaphoreGuard contention benchmark ===");
+
+    xDataMutex = xSemaphoreCreateMutex();
+    if (!xDataMutex) {
+        Serial.println("Failed to create mutex!");
+        return;
+    }
+
+    // Writer gets the highest priority, as the IMU task does in production
+    xTaskCreatePinnedToCore(writerTask, "imu", 4096, nullptr, 5, nullptr, 1);
+    for (int i = 0; i < kReaders; i++) {
+        xTaskCreatePinnedToCore(readerTask, "reader", 4096,
+                                reinterpret_cast<void*>(static_cast<intptr_t>(i)),
+                                2, nullptr, i % 2);
+    }
+
+    runPhase(Mode::Mutex, "mutex");
+    runPhase(Mode::SeqLock, "seqlock");
+}
+
+void loop() {
+    delay(1000);
+}
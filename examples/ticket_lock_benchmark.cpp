@@ -0,0 +1,132 @@
+// Fairness benchmark: TicketLock versus SemaphoreGuard with three tasks of
+// equal priority on two cores.
+//
+// Tasks A (core 0) and B (core 1) hammer the lock with short critical
+// sections and almost no gap; task C (core 0) needs the lock now and then.
+// With a FreeRTOS mutex A and B can keep trading the lock while C waits.
+// The sketch reports each task's acquisition count and wait-time
+// percentiles (from a power-of-two histogram) for both locks.
+#include <Arduino.h>
+#include <string.h>
+#include "SemaphoreGuard.h"
+#include "TicketLock.h"
+
+enum class Mode { Mutex, Ticket, Stopped };
+
+static constexpr int kTasks = 3;
+static constexpr int kBuckets = 32;
+static constexpr uint32_t kRunMs = 5000;
+
+struct WaitStats {
+    uint32_t histogram[kBuckets];  // Bucket i counts waits in [2^i, 2^(i+1)) cycles
+    uint32_t count;
+    uint32_t maxCycles;
+};
+
+static volatile Mode gMode = Mode::Stopped;
+static SemaphoreHandle_t xMutex = nullptr;
+static TicketLock gTicket;
+static WaitStats gStats[kTasks];
+static volatile uint32_t gShared = 0;
+
+static void record(WaitStats& stats, uint32_t cycles) {
+    const int bucket = cycles == 0 ? 0 : 31 - __builtin_clz(cycles);
+    stats.histogram[bucket]++;
+    stats.count++;
+    if (cycles > stats.maxCycles) {
+        stats.maxCycles = cycles;
+    }
+}
+
+// Upper bound of the bucket holding the given percentile
+static uint32_t percentile(const WaitStats& stats, uint32_t permille) {
+    const uint32_t target = (uint64_t)stats.count * permille / 1000;
+    uint32_t seen = 0;
+    for (int i = 0; i < kBuckets; i++) {
+        seen += stats.histogram[i];
+        if (seen > target) {
+            return i >= 31 ? UINT32_MAX : (2UL << i);
+        }
+    }
+    return stats.maxCycles;
+}
+
+static void workerTask(void* param) {
+    const int id = static_cast<int>(reinterpret_cast<intptr_t>(param));
+    // A and B are greedy; C only wants the lock every millisecond
+    const bool greedy = id < 2;
+    while (true) {
+        const Mode mode = gMode;
+        if (mode == Mode::Stopped) {
+            vTaskDelay(1);
+            continue;
+        }
+
+        const uint32_t start = ESP.getCycleCount();
+        if (mode == Mode::Mutex) {
+            SEMAPHORE_GUARD(xMutex);
+            record(gStats[id], ESP.getCycleCount() - start);
+            gShared = gShared + 1;
+            delayMicroseconds(20);
+        } else {
+            TICKET_LOCK_GUARD(gTicket);
+            record(gStats[id], ESP.getCycleCount() - start);
+            gShared = gShared + 1;
+            delayMicroseconds(20);
+        }
+
+        if (!greedy) {
+            vTaskDelay(1);
+        }
+    }
+}
+
+static void runPhase(Mode mode, const char* name) {
+    memset(gStats, 0, sizeof(gStats));
+    gMode = mode;
+    delay(kRunMs);
+    gMode = Mode::Stopped;
+    delay(50);
+
+    const uint32_t mhz = ESP.getCpuFreqMHz();
+    Serial.printf("--- %s ---\n", name);
+    for (int i = 0; i < kTasks; i++) {
+        const WaitStats& stats = gStats[i];
+        Serial.printf("task %c  acquisitions=%6lu  p50<%6lu us  p99<%6lu us  p99.9<%6lu us  max=%6lu us\n",
+                      'A' + i,
+                      (unsigned long)stats.count,
+                      (unsigned long)(percentile(stats, 500) / mhz),
+                      (unsigned long)(percentile(stats, 990) / mhz),
+                      (unsigned long)(percentile(stats, 999) / mhz),
+                      (unsigned long)(stats.maxCycles / mhz));
+    }
+    if (mode == Mode::Ticket) {
+        Serial.printf("handoffs=%lu\n", (unsigned long)gTicket.handoffs());
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.println("\n=== TicketLock fairness benchmark ===");
+
+    xMutex = xSemaphoreCreateMutex();
+    if (!xMutex) {
+        Serial.println("Failed to create mutex!");
+        return;
+    }
+
+    const BaseType_t cores[kTasks] = {0, 1, 0};
+    for (int i = 0; i < kTasks; i++) {
+        xTaskCreatePinnedToCore(workerTask, "worker", 4096,
+                                reinterpret_cast<void*>(static_cast<intptr_t>(i)),
+                                2, nullptr, cores[i]);
+    }
+
+    runPhase(Mode::Mutex, "SemaphoreGuard");
+    runPhase(Mode::Ticket, "TicketLockGuard");
+}
+
+void loop() {
+    delay(1000);
+}
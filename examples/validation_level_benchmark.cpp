@@ -0,0 +1,79 @@
+// Cost of the constructor checks at each SEMAPHORE_GUARD_VALIDATION level.
+//
+// Build this sketch three times, with -DSEMAPHORE_GUARD_VALIDATION=2, =1
+// and =0, and compare the output. The guard is first measured around an
+// acquire policy that does nothing, which leaves only the checks, the
+// flag and the policies in the loop; then around a real mutex.
+//
+// For code size, compare the guarded functions below across the three
+// builds, e.g.
+//     xtensa-esp32-elf-nm --size-sort -C .pio/build/*/firmware.elf | grep guarded
+// or the .text line of `pio run -t size`. Level 1 is only smaller than 2
+// when configASSERT() is compiled out (CONFIG_FREERTOS_ASSERT_DISABLE).
+#include <Arduino.h>
+#include "SemaphoreGuard.h"
+
+static constexpr uint32_t kIterations = 100000;
+
+// Takes nothing: leaves only the guard in the loop
+struct NullAcquire {
+    static bool take(SemaphoreHandle_t, TickType_t) { return true; }
+    static void give(SemaphoreHandle_t) {}
+};
+
+typedef BasicSemaphoreGuard<NullAcquire, NoTiming, NoStats, SemaphoreLog> BareGuard;
+
+static SemaphoreHandle_t xMutex = nullptr;
+static volatile uint32_t gCounter = 0;
+
+// Kept out of line so their size shows up in the symbol table
+__attribute__((noinline)) void guardedBare(SemaphoreHandle_t handle) {
+    BareGuard guard(handle);
+    if (guard.hasLock()) {
+        gCounter = gCounter + 1;
+    }
+}
+
+__attribute__((noinline)) void guardedMutex(SemaphoreHandle_t handle) {
+    SemaphoreGuard guard(handle);
+    if (guard.hasLock()) {
+        gCounter = gCounter + 1;
+    }
+}
+
+__attribute__((noinline)) void guardedByHand(SemaphoreHandle_t handle) {
+    if (xSemaphoreTake(handle, portMAX_DELAY) == pdTRUE) {
+        gCounter = gCounter + 1;
+        xSemaphoreGive(handle);
+    }
+}
+
+static void measure(const char* name, void (*body)(SemaphoreHandle_t)) {
+    const uint32_t start = ESP.getCycleCount();
+    for (uint32_t i = 0; i < kIterations; i++) {
+        body(xMutex);
+    }
+    const uint32_t cycles = ESP.getCycleCount() - start;
+    Serial.printf("%-20s %4lu cycles per call\n", name, (unsigned long)(cycles / kIterations));
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(1000);
+    Serial.printf("\n=== Guard validation level benchmark (SEMAPHORE_GUARD_VALIDATION=%d) ===\n",
+                  SEMAPHORE_GUARD_VALIDATION);
+
+    xMutex = xSemaphoreCreateMutex();
+    if (!xMutex) {
+        Serial.println("Failed to create mutex!");
+        return;
+    }
+
+    measure("guard, no kernel", guardedBare);
+    measure("SemaphoreGuard", guardedMutex);
+    measure("hand-written", guardedByHand);
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,203 @@
+#include "AsyncLockDispatcher.h"
+#include "CriticalSectionGuard.h"
+
+AsyncLockDispatcher::AsyncLockDispatcher()
+    : m_free(nullptr), m_head(nullptr), m_tail(nullptr), m_outstanding(0), m_task(nullptr),
+      m_starting(false) {
+    portMUX_INITIALIZE(&m_mux);
+    for (size_t i = 0; i < SEMAPHORE_GUARD_ASYNC_POOL_SIZE; i++) {
+        m_pool[i].next = m_free;
+        m_free = &m_pool[i];
+    }
+}
+
+AsyncLockDispatcher& AsyncLockDispatcher::instance() {
+    static AsyncLockDispatcher dispatcher;
+    return dispatcher;
+}
+
+bool AsyncLockDispatcher::begin(UBaseType_t priority, BaseType_t core, uint32_t stackSize) {
+    bool creator = false;
+    while (true) {
+        {
+            CriticalSectionGuard guard(&m_mux);
+            if (m_task != nullptr) {
+                return true;
+            }
+            if (!m_starting) {
+                m_starting = true;
+                creator = true;
+            }
+        }
+        if (creator) {
+            break;
+        }
+        // Another task is creating the dispatcher; report its outcome
+        vTaskDelay(1);
+        CriticalSectionGuard guard(&m_mux);
+        if (!m_starting) {
+            return m_task != nullptr;
+        }
+    }
+
+    TaskHandle_t task = nullptr;
+    const bool created = xTaskCreatePinnedToCore(taskEntry, "asynclock", stackSize, this,
+                                                 priority, &task, core) == pdPASS;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        m_task = created ? task : nullptr;
+        m_starting = false;
+    }
+    if (!created) {
+        ALD_LOG_E("Failed to create dispatcher task");
+    }
+    return created;
+}
+
+bool AsyncLockDispatcher::asyncAcquire(SemaphoreHandle_t handle, AsyncLockCallback callback,
+                                       void* context, TickType_t timeout) {
+    if (handle == nullptr || callback == nullptr) {
+        ALD_LOG_E("Null semaphore handle or callback provided");
+        return false;
+    }
+    if (m_task == nullptr) {
+        ALD_LOG_E("Dispatcher not started; call begin() first");
+        return false;
+    }
+
+    const TickType_t start = xTaskGetTickCount();
+    bool queued = false;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        Request* request = m_free;
+        if (request != nullptr) {
+            m_free = request->next;
+            request->handle = handle;
+            request->callback = callback;
+            request->context = context;
+            request->start = start;
+            request->timeout = timeout;
+            request->next = nullptr;
+            if (m_tail != nullptr) {
+                m_tail->next = request;
+            } else {
+                m_head = request;
+            }
+            m_tail = request;
+            m_outstanding++;
+            queued = true;
+        }
+    }
+
+    if (!queued) {
+        ALD_LOG_W("Request pool exhausted (%d entries)", SEMAPHORE_GUARD_ASYNC_POOL_SIZE);
+        return false;
+    }
+
+    xTaskNotifyGive(m_task);
+    return true;
+}
+
+size_t AsyncLockDispatcher::pending() const {
+    CriticalSectionGuard guard(&m_mux);
+    return m_outstanding;
+}
+
+void AsyncLockDispatcher::taskEntry(void* param) {
+    static_cast<AsyncLockDispatcher*>(param)->run();
+}
+
+void AsyncLockDispatcher::run() {
+    bool waiting = false;
+    while (true) {
+        // Sleep until a new request arrives; poll every tick while any
+        // request is still waiting for its lock
+        ulTaskNotifyTake(pdTRUE, waiting ? 1 : portMAX_DELAY);
+        waiting = dispatchPending();
+    }
+}
+
+bool AsyncLockDispatcher::dispatchPending() {
+    // Detach the queue so callbacks run outside the critical section
+    Request* list;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        list = m_head;
+        m_head = nullptr;
+        m_tail = nullptr;
+    }
+
+    Request* keepHead = nullptr;
+    Request* keepTail = nullptr;
+    const TickType_t now = xTaskGetTickCount();
+
+    // Handles an older request is still waiting for in this pass. Later
+    // requests on them are not granted even if the lock frees up meanwhile,
+    // so each handle is granted in request order
+    SemaphoreHandle_t busy[SEMAPHORE_GUARD_ASYNC_POOL_SIZE];
+    size_t busyCount = 0;
+
+    while (list != nullptr) {
+        Request* request = list;
+        list = list->next;
+        request->next = nullptr;
+
+        bool behind = false;
+        for (size_t i = 0; i < busyCount && !behind; i++) {
+            behind = (busy[i] == request->handle);
+        }
+        const bool expired = request->timeout != portMAX_DELAY &&
+                             (TickType_t)(now - request->start) >= request->timeout;
+
+        bool done = false;
+        if (!behind || expired) {
+            SemaphoreGuard guard(request->handle, 0);
+            if (behind) {
+                // Only reporting the timeout; the lock belongs to the older request
+                guard.unlock();
+            }
+            done = guard.hasLock() || expired;
+            if (done) {
+                request->callback(guard, request->context);
+            }
+        }
+        if (!done && !behind) {
+            busy[busyCount++] = request->handle;
+        }
+
+        if (done) {
+            releaseRequest(request);
+        } else if (keepTail != nullptr) {
+            keepTail->next = request;
+            keepTail = request;
+        } else {
+            keepHead = keepTail = request;
+        }
+    }
+
+    if (keepHead == nullptr) {
+        CriticalSectionGuard guard(&m_mux);
+        return m_head != nullptr;
+    }
+
+    // Requests still waiting go back in front of anything queued meanwhile
+    CriticalSectionGuard guard(&m_mux);
+    keepTail->next = m_head;
+    if (m_head == nullptr) {
+        m_tail = keepTail;
+    }
+    m_head = keepHead;
+    return true;
+}
+
+void AsyncLockDispatcher::releaseRequest(Request* request) {
+    CriticalSectionGuard guard(&m_mux);
+    request->next = m_free;
+    m_free = request;
+    m_outstanding--;
+}
+
+bool asyncAcquire(SemaphoreHandle_t handle, AsyncLockCallback callback,
+                  void* context, TickType_t timeout) {
+    return AsyncLockDispatcher::instance().asyncAcquire(handle, callback, context, timeout);
+}
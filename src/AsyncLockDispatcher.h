@@ -0,0 +1,92 @@
+#ifndef _ASYNC_LOCK_DISPATCHER_H_
+#define _ASYNC_LOCK_DISPATCHER_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+#include "SemaphoreGuard.h"
+
+// Maximum number of outstanding asyncAcquire() requests per dispatcher
+#ifndef SEMAPHORE_GUARD_ASYNC_POOL_SIZE
+#define SEMAPHORE_GUARD_ASYNC_POOL_SIZE 16
+#endif
+
+// Invoked on the dispatcher task. guard.hasLock() is true when the lock was
+// acquired and false when the request timed out; the lock is released when
+// the callback returns.
+typedef void (*AsyncLockCallback)(SemaphoreGuard& guard, void* context);
+
+// Non-blocking lock acquisition for event-loop tasks.
+//
+// asyncAcquire() queues a request and returns immediately. A dedicated
+// dispatcher task tries each pending lock without blocking, runs the
+// callback with a held guard as soon as the lock is free and reports
+// timeouts through the same callback. FreeRTOS has no "semaphore became
+// free" event that works for mutexes, so pending requests are re-tried
+// every tick: grant latency is at most one tick after release.
+//
+// Requests live in a fixed pool of SEMAPHORE_GUARD_ASYNC_POOL_SIZE entries;
+// nothing is allocated per request. Requests on the same handle are granted
+// in request order; requests on different handles complete independently,
+// so their callbacks may run in any order.
+class AsyncLockDispatcher {
+public:
+    AsyncLockDispatcher();
+
+    // Delete copy and move; the dispatcher task refers to this instance
+    AsyncLockDispatcher(const AsyncLockDispatcher&) = delete;
+    AsyncLockDispatcher& operator=(const AsyncLockDispatcher&) = delete;
+    AsyncLockDispatcher(AsyncLockDispatcher&&) = delete;
+    AsyncLockDispatcher& operator=(AsyncLockDispatcher&&) = delete;
+
+    // Start the dispatcher task. Callbacks run at this priority and core.
+    // Safe to call from several tasks; only the first call creates the task
+    bool begin(UBaseType_t priority = 5, BaseType_t core = tskNO_AFFINITY,
+               uint32_t stackSize = 4096);
+
+    // Queue a request. Returns false if the dispatcher is not running, the
+    // arguments are invalid or the pool is exhausted; the callback is then
+    // never invoked
+    bool asyncAcquire(SemaphoreHandle_t handle, AsyncLockCallback callback,
+                      void* context, TickType_t timeout = portMAX_DELAY);
+
+    // Requests queued and not yet completed
+    [[nodiscard]] size_t pending() const;
+
+    // Check if the dispatcher task is running
+    [[nodiscard]] bool isRunning() const noexcept { return m_task != nullptr; }
+
+    // Shared dispatcher used by the free asyncAcquire() function
+    static AsyncLockDispatcher& instance();
+
+private:
+    struct Request {
+        SemaphoreHandle_t handle;
+        AsyncLockCallback callback;
+        void* context;
+        TickType_t start;
+        TickType_t timeout;
+        Request* next;
+    };
+
+    static void taskEntry(void* param);
+    void run();
+    bool dispatchPending();
+    void releaseRequest(Request* request);
+
+    Request m_pool[SEMAPHORE_GUARD_ASYNC_POOL_SIZE];
+    Request* m_free;
+    Request* m_head;  // FIFO of pending requests, guarded by m_mux
+    Request* m_tail;
+    size_t m_outstanding;  // Queued or being dispatched, guarded by m_mux
+    mutable portMUX_TYPE m_mux;
+    TaskHandle_t m_task;
+    bool m_starting;  // begin() is creating the task, guarded by m_mux
+};
+
+// Queue a request on AsyncLockDispatcher::instance(); call
+// AsyncLockDispatcher::instance().begin() once during setup
+bool asyncAcquire(SemaphoreHandle_t handle, AsyncLockCallback callback,
+                  void* context, TickType_t timeout = portMAX_DELAY);
+
+#endif  // _ASYNC_LOCK_DISPATCHER_H_
@@ -0,0 +1,220 @@
+#include "AsyncSemaphore.h"
+
+#ifdef SEMAPHORE_GUARD_HAS_COROUTINES
+#include "CriticalSectionGuard.h"
+#include <freertos/semphr.h>
+
+// All waiter list manipulation happens inside m_mux. Coroutines are only
+// handed to the executor after leaving the critical section, and a waiter
+// is never touched again once posted: the coroutine may resume and destroy
+// its frame (which holds the waiter) right away on another core.
+
+AsyncSemaphore::AsyncSemaphore(AsyncExecutor& executor, uint32_t permits)
+    : m_executor(executor), m_available(permits), m_head(nullptr), m_tail(nullptr),
+      m_armGeneration(0) {
+    portMUX_INITIALIZE(&m_mux);
+    // Auto-reload: a period change that cannot be queued from the timer
+    // task leaves the timer firing at its old period, so no timeout is lost
+    m_timer = xTimerCreateStatic("asyncsem", 1, pdTRUE, this, timerCallback, &m_timerBuffer);
+}
+
+static void signalTimerDeleted(void* done, uint32_t) {
+    xSemaphoreGive(static_cast<SemaphoreHandle_t>(done));
+}
+
+AsyncSemaphore::~AsyncSemaphore() {
+    if (m_timer == nullptr) {
+        return;
+    }
+
+    // xTimerDelete() only queues a command, and m_timerBuffer dies with this
+    // object. Timer commands run in order, so wait for a function call
+    // queued behind the delete
+    StaticSemaphore_t doneBuffer;
+    SemaphoreHandle_t done = xSemaphoreCreateBinaryStatic(&doneBuffer);
+    xTimerDelete(m_timer, portMAX_DELAY);
+    if (xTimerPendFunctionCall(signalTimerDeleted, done, 0, portMAX_DELAY) == pdPASS) {
+        xSemaphoreTake(done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(done);
+}
+
+bool AsyncSemaphore::LockAwaiter::await_ready() noexcept {
+    if (m_sem.tryAcquire()) {
+        m_state = State::Granted;
+        return true;
+    }
+    return false;
+}
+
+bool AsyncSemaphore::LockAwaiter::await_suspend(std::coroutine_handle<> handle) noexcept {
+    AsyncSemaphore& sem = m_sem;
+    const bool timed = (m_timeout != portMAX_DELAY);
+    m_handle = handle;
+    m_start = xTaskGetTickCount();
+
+    {
+        CriticalSectionGuard guard(&sem.m_mux);
+        // Re-check: a permit may have been released since await_ready()
+        if (sem.m_available > 0) {
+            sem.m_available--;
+            m_state = State::Granted;
+            return false;
+        }
+        if (m_timeout == 0) {
+            m_state = State::TimedOut;
+            return false;
+        }
+
+        m_prev = sem.m_tail;
+        m_next = nullptr;
+        if (sem.m_tail != nullptr) {
+            sem.m_tail->m_next = this;
+        } else {
+            sem.m_head = this;
+        }
+        sem.m_tail = this;
+        if (timed) {
+            sem.m_armGeneration.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    // From here on this awaiter may already have been granted and resumed
+    if (timed) {
+        sem.armTimer();
+    }
+    return true;
+}
+
+AsyncSemaphore::Guard AsyncSemaphore::LockAwaiter::await_resume() noexcept {
+    return Guard(m_state == State::Granted ? &m_sem : nullptr);
+}
+
+AsyncSemaphore::Guard AsyncSemaphore::tryLock() noexcept {
+    return Guard(tryAcquire() ? this : nullptr);
+}
+
+uint32_t AsyncSemaphore::available() const noexcept {
+    CriticalSectionGuard guard(&m_mux);
+    return m_available;
+}
+
+bool AsyncSemaphore::tryAcquire() noexcept {
+    CriticalSectionGuard guard(&m_mux);
+    // Queued waiters go first so a late arrival cannot overtake them
+    if (m_available > 0 && m_head == nullptr) {
+        m_available--;
+        return true;
+    }
+    return false;
+}
+
+void AsyncSemaphore::release() noexcept {
+    std::coroutine_handle<> next;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        if (m_head != nullptr) {
+            // Hand the permit straight to the oldest waiter
+            LockAwaiter* waiter = m_head;
+            unlink(waiter);
+            waiter->m_state = LockAwaiter::State::Granted;
+            next = waiter->m_handle;
+        } else {
+            m_available++;
+        }
+    }
+    if (next) {
+        m_executor.post(next);
+    }
+}
+
+void AsyncSemaphore::unlink(LockAwaiter* waiter) noexcept {
+    if (waiter->m_prev != nullptr) {
+        waiter->m_prev->m_next = waiter->m_next;
+    } else {
+        m_head = waiter->m_next;
+    }
+    if (waiter->m_next != nullptr) {
+        waiter->m_next->m_prev = waiter->m_prev;
+    } else {
+        m_tail = waiter->m_prev;
+    }
+    waiter->m_next = nullptr;
+    waiter->m_prev = nullptr;
+}
+
+void AsyncSemaphore::armTimer() noexcept {
+    if (m_timer == nullptr) {
+        return;
+    }
+
+    // Repeat if another waiter was queued meanwhile, so the last period set
+    // always accounts for the earliest deadline
+    uint32_t generation;
+    do {
+        generation = m_armGeneration.load(std::memory_order_relaxed);
+
+        bool pending = false;
+        TickType_t earliest = portMAX_DELAY;
+        const TickType_t now = xTaskGetTickCount();
+        {
+            CriticalSectionGuard guard(&m_mux);
+            for (LockAwaiter* w = m_head; w != nullptr; w = w->m_next) {
+                if (w->m_timeout == portMAX_DELAY) {
+                    continue;
+                }
+                const TickType_t elapsed = now - w->m_start;
+                const TickType_t remaining = (elapsed >= w->m_timeout) ? 0 : w->m_timeout - elapsed;
+                if (remaining < earliest) {
+                    earliest = remaining;
+                }
+                pending = true;
+            }
+        }
+
+        // The timer task itself must not block on its own command queue.
+        // If a command cannot be queued there, the auto-reload timer fires
+        // again at its old period and this runs once more
+        const TickType_t wait =
+            xTaskGetCurrentTaskHandle() == xTimerGetTimerDaemonTaskHandle() ? 0 : portMAX_DELAY;
+        if (!pending) {
+            xTimerStop(m_timer, wait);
+        } else if (xTimerChangePeriod(m_timer, earliest > 0 ? earliest : 1, wait) != pdPASS) {
+            return;
+        }
+    } while (generation != m_armGeneration.load(std::memory_order_relaxed));
+}
+
+void AsyncSemaphore::expireWaiters() noexcept {
+    LockAwaiter* expired = nullptr;
+    const TickType_t now = xTaskGetTickCount();
+    {
+        CriticalSectionGuard guard(&m_mux);
+        LockAwaiter* w = m_head;
+        while (w != nullptr) {
+            LockAwaiter* next = w->m_next;
+            if (w->m_timeout != portMAX_DELAY && (TickType_t)(now - w->m_start) >= w->m_timeout) {
+                unlink(w);
+                w->m_state = LockAwaiter::State::TimedOut;
+                // Reuse m_next to chain the expired waiters locally
+                w->m_next = expired;
+                expired = w;
+            }
+            w = next;
+        }
+    }
+
+    while (expired != nullptr) {
+        LockAwaiter* next = expired->m_next;
+        m_executor.post(expired->m_handle);
+        expired = next;
+    }
+
+    armTimer();
+}
+
+void AsyncSemaphore::timerCallback(TimerHandle_t timer) {
+    static_cast<AsyncSemaphore*>(pvTimerGetTimerID(timer))->expireWaiters();
+}
+
+#endif  // SEMAPHORE_GUARD_HAS_COROUTINES
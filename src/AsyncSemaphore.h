@@ -0,0 +1,138 @@
+#ifndef _ASYNC_SEMAPHORE_H_
+#define _ASYNC_SEMAPHORE_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/timers.h>
+
+// C++20 coroutine support is required; the header is empty otherwise so the
+// library still builds with older language standards
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+#define SEMAPHORE_GUARD_HAS_COROUTINES 1
+#include <atomic>
+#include <coroutine>
+
+// Runs resumed coroutines. post() may be called from any task (the task
+// releasing the semaphore or the FreeRTOS timer task for timeouts), so
+// implementations must be thread-safe, e.g. by feeding a FreeRTOS queue.
+class AsyncExecutor {
+public:
+    virtual ~AsyncExecutor() = default;
+    virtual void post(std::coroutine_handle<> handle) = 0;
+};
+
+// Counting semaphore for coroutines. Waiting suspends the coroutine instead
+// of blocking a FreeRTOS task, so many sessions can share a few task stacks.
+//
+//     AsyncSemaphore::Guard guard = co_await sem.lock();
+//     AsyncSemaphore::Guard maybe = co_await sem.lockFor(pdMS_TO_TICKS(50));
+//     if (maybe.hasLock()) { ... }
+//
+// Waiters are granted in FIFO order and resumed through the executor given
+// to the constructor. The waiter record lives in the coroutine frame, so no
+// memory is allocated per lock() call. The destructor waits until the timer
+// task has deleted the timeout timer, so it must not run on the timer task.
+class AsyncSemaphore {
+public:
+    // Move-only RAII ownership of one permit
+    class Guard {
+    public:
+        Guard() noexcept : m_sem(nullptr) {}
+        Guard(Guard&& other) noexcept : m_sem(other.m_sem) { other.m_sem = nullptr; }
+        Guard& operator=(Guard&& other) noexcept {
+            if (this != &other) {
+                unlock();
+                m_sem = other.m_sem;
+                other.m_sem = nullptr;
+            }
+            return *this;
+        }
+        ~Guard() { unlock(); }
+
+        // Delete copy constructor and copy assignment to prevent double-release
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+
+        // Check if a permit is held
+        [[nodiscard]] bool hasLock() const noexcept { return m_sem != nullptr; }
+
+        // Release early; the destructor then does nothing
+        void unlock() noexcept {
+            if (m_sem != nullptr) {
+                m_sem->release();
+                m_sem = nullptr;
+            }
+        }
+
+    private:
+        friend class AsyncSemaphore;
+        explicit Guard(AsyncSemaphore* sem) noexcept : m_sem(sem) {}
+
+        AsyncSemaphore* m_sem;
+    };
+
+    // Awaitable returned by lock() / lockFor(); co_await yields a Guard
+    class LockAwaiter {
+    public:
+        bool await_ready() noexcept;
+        bool await_suspend(std::coroutine_handle<> handle) noexcept;
+        Guard await_resume() noexcept;
+
+    private:
+        friend class AsyncSemaphore;
+
+        enum class State : uint8_t { Waiting, Granted, TimedOut };
+
+        LockAwaiter(AsyncSemaphore& sem, TickType_t timeout) noexcept
+            : m_sem(sem), m_timeout(timeout), m_start(0), m_state(State::Waiting),
+              m_next(nullptr), m_prev(nullptr) {}
+
+        AsyncSemaphore& m_sem;
+        TickType_t m_timeout;
+        TickType_t m_start;
+        State m_state;
+        std::coroutine_handle<> m_handle;
+        LockAwaiter* m_next;  // Intrusive FIFO links, guarded by m_sem.m_mux
+        LockAwaiter* m_prev;
+    };
+
+    explicit AsyncSemaphore(AsyncExecutor& executor, uint32_t permits = 1);
+    ~AsyncSemaphore();
+
+    // Delete copy and move; waiters and guards refer to this instance
+    AsyncSemaphore(const AsyncSemaphore&) = delete;
+    AsyncSemaphore& operator=(const AsyncSemaphore&) = delete;
+    AsyncSemaphore(AsyncSemaphore&&) = delete;
+    AsyncSemaphore& operator=(AsyncSemaphore&&) = delete;
+
+    // Wait without limit; the resulting Guard always holds a permit
+    [[nodiscard]] LockAwaiter lock() noexcept { return LockAwaiter(*this, portMAX_DELAY); }
+
+    // Wait at most timeout ticks; check hasLock() on the resulting Guard
+    [[nodiscard]] LockAwaiter lockFor(TickType_t timeout) noexcept { return LockAwaiter(*this, timeout); }
+
+    // Take a permit only if one is free right now
+    [[nodiscard]] Guard tryLock() noexcept;
+
+    // Permits currently available
+    [[nodiscard]] uint32_t available() const noexcept;
+
+private:
+    bool tryAcquire() noexcept;
+    void release() noexcept;
+    void unlink(LockAwaiter* waiter) noexcept;
+    void armTimer() noexcept;
+    void expireWaiters() noexcept;
+    static void timerCallback(TimerHandle_t timer);
+
+    AsyncExecutor& m_executor;
+    mutable portMUX_TYPE m_mux;
+    uint32_t m_available;
+    LockAwaiter* m_head;
+    LockAwaiter* m_tail;
+    StaticTimer_t m_timerBuffer;
+    TimerHandle_t m_timer;
+    std::atomic<uint32_t> m_armGeneration;  // Bumped whenever a timed waiter is queued
+};
+
+#endif  // __cpp_impl_coroutine
+
+#endif  // _ASYNC_SEMAPHORE_H_
@@ -0,0 +1,417 @@
+#ifndef _BASIC_SEMAPHORE_GUARD_H_
+#define _BASIC_SEMAPHORE_GUARD_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "SemaphoreGuardPolicies.h"
+#include "SemaphoreHandles.h"
+#include "Deadline.h"
+#include "SemaphoreWaiters.h"
+#include <type_traits>
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+#include "HeldList.h"
+#endif
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+#include "RecursiveOwnership.h"
+#endif
+
+// How much the constructors check before taking:
+//   2  null handle and ISR context, logged, guard fails (default)
+//   1  configASSERT() only, no logging
+//   0  nothing: the guard is take, flag, give
+// Without the macro, CONFIG_SEMAPHORE_GUARD_VALIDATION from sdkconfig is used
+#ifndef SEMAPHORE_GUARD_VALIDATION
+#ifdef CONFIG_SEMAPHORE_GUARD_VALIDATION
+#define SEMAPHORE_GUARD_VALIDATION CONFIG_SEMAPHORE_GUARD_VALIDATION
+#else
+#define SEMAPHORE_GUARD_VALIDATION 2
+#endif
+#endif
+
+static_assert(SEMAPHORE_GUARD_VALIDATION >= 0 && SEMAPHORE_GUARD_VALIDATION <= 2,
+              "SEMAPHORE_GUARD_VALIDATION must be 0, 1 or 2");
+
+// The constructors and lock() report __builtin_return_address(0) as their
+// call site. Inlined, that is the return address of the function holding
+// the guard, not the guard's own line, so they are kept out of line when a
+// feature that prints call sites is built in
+#if defined(SEMAPHORE_GUARD_HELD_LOCK_TABLE) || defined(SEMAPHORE_GUARD_SAMPLING_PROFILER) || \
+    defined(SEMAPHORE_GUARD_HELD_LIST)
+#define SEMAPHORE_GUARD_SITE_NOINLINE __attribute__((noinline))
+#else
+#define SEMAPHORE_GUARD_SITE_NOINLINE
+#endif
+
+// RAII guard shared by SemaphoreGuard and RecursiveSemaphoreGuard.
+//
+//   AcquirePolicy  take()/give() on the kernel object
+//   TimingPolicy   markAcquired()/heldTicks(), inherited (empty when unused)
+//   StatsPolicy    onAcquireStart()/onAcquireEnd()/onRelease(), inherited;
+//                  onAcquireEnd() also receives the GuardSite
+//   LogPolicy      static message functions, see SEMAPHORE_GUARD_LOG_POLICY
+//
+// Every acquisition funnels through acquire() and every release through
+// release(), so new features are written once for both guard types. With
+// -DSEMAPHORE_GUARD_HELD_LIST each guard also links itself into its task's
+// HeldList and refuses takes that would deadlock on the task itself; with
+// -DSEMAPHORE_GUARD_RECURSIVE_FAST_PATH a recursive guard nested in another
+// guard on the same mutex only counts depth (RecursiveOwnership). The
+// default instantiations are compiled once in SemaphoreGuard.cpp and
+// RecursiveSemaphoreGuard.cpp; custom combinations are instantiated
+// wherever they are used.
+template <typename AcquirePolicy, typename TimingPolicy, typename StatsPolicy, typename LogPolicy>
+class BasicSemaphoreGuard : private TimingPolicy, private StatsPolicy {
+public:
+    // Constructor: Takes the semaphore with an infinite timeout
+    explicit BasicSemaphoreGuard(SemaphoreHandle_t handle);
+
+    // Constructor: Takes the semaphore with a provided timeout
+    BasicSemaphoreGuard(SemaphoreHandle_t handle, TickType_t timeout);
+
+    // Constructor: Takes the semaphore using only the time left before the deadline
+    BasicSemaphoreGuard(SemaphoreHandle_t handle, const Deadline& deadline);
+
+    // Destructor: Gives the semaphore back
+    ~BasicSemaphoreGuard();
+
+    // Delete copy constructor and copy assignment to prevent double-release
+    BasicSemaphoreGuard(const BasicSemaphoreGuard&) = delete;
+    BasicSemaphoreGuard& operator=(const BasicSemaphoreGuard&) = delete;
+
+    // Delete move constructor and move assignment for safety
+    BasicSemaphoreGuard(BasicSemaphoreGuard&&) = delete;
+    BasicSemaphoreGuard& operator=(BasicSemaphoreGuard&&) = delete;
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+    // Debug constructors with file/line info
+    BasicSemaphoreGuard(SemaphoreHandle_t handle, const char* file, int line);
+    BasicSemaphoreGuard(SemaphoreHandle_t handle, TickType_t timeout, const char* file, int line);
+    BasicSemaphoreGuard(SemaphoreHandle_t handle, const Deadline& deadline, const char* file, int line);
+#endif
+
+    // Typed handle constructors: only compile when the handle's kind uses
+    // this guard's acquire policy
+    template <typename Kind, typename... Args>
+    explicit BasicSemaphoreGuard(TypedSemaphoreHandle<Kind> handle, Args... args)
+        : BasicSemaphoreGuard(handle.get(), args...) {
+        static_assert(std::is_same<typename Kind::Acquire, AcquirePolicy>::value,
+                      "Handle kind does not match this guard (e.g. a recursive mutex passed to "
+                      "SemaphoreGuard); use SemaphoreGuardFor<decltype(handle)> or SEMAPHORE_GUARD()");
+    }
+
+    // Check if the semaphore was successfully acquired
+    [[nodiscard]] bool hasLock() const noexcept { return m_taken; }
+
+    // Get the semaphore handle (for advanced use cases)
+    [[nodiscard]] SemaphoreHandle_t getHandle() const noexcept { return m_handle; }
+
+    // Check if this guard is valid (has non-null handle)
+    [[nodiscard]] bool isValid() const noexcept { return m_handle != nullptr; }
+
+    // Check if acquisition failed because the deadline's budget ran out
+    [[nodiscard]] bool deadlineExpired() const noexcept { return m_deadlineExpired; }
+
+    // Release early; the destructor then does nothing unless lock() is called
+    void unlock();
+
+    // Take the semaphore again after unlock(); returns hasLock()
+    bool lock(TickType_t timeout = portMAX_DELAY);
+
+    // Check if another guard is blocked on this semaphore (SemaphoreWaiters)
+    [[nodiscard]] bool hasWaiters() const noexcept { return m_taken && SemaphoreWaiters::any(m_handle); }
+
+    // In long critical sections: if another guard waits, release, wait
+    // until a waiter has taken the semaphore (at most
+    // SEMAPHORE_GUARD_HANDOFF_TICKS) and take it again; returns hasLock().
+    // A nested recursive guard keeps the mutex, since its outer guard holds it
+    bool yieldIfContended(TickType_t timeout = portMAX_DELAY);
+
+private:
+    // Null-handle and ISR-context checks shared by all constructors, as
+    // selected by SEMAPHORE_GUARD_VALIDATION
+    bool usable();
+    GuardSite callSite(const void* caller) const;
+    // Inlined into each constructor, as the take was before both guards
+    // shared this class: an out-of-line copy costs more in call overhead
+    // than it saves (see examples/guard_policy_benchmark.cpp)
+    __attribute__((always_inline)) void acquire(TickType_t timeout, const GuardSite& site);
+    void release();
+
+    SemaphoreHandle_t m_handle;
+    bool m_taken;  // Indicates whether the semaphore was successfully taken
+    bool m_deadlineExpired;  // Failed because a Deadline left no time
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+    const char* m_file = nullptr;
+    int m_line = 0;
+#endif
+
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+    HeldListNode m_held;  // This guard's entry in its task's held list
+#endif
+
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+    RecursiveOwnerNode m_node;  // Depth count when this guard took the kernel mutex
+    RecursiveOwnerNode* m_owner = nullptr;  // Node this guard counts on while held
+    bool m_nested = false;  // Taken through the fast path
+#endif
+};
+
+template <typename A, typename T, typename S, typename L>
+SEMAPHORE_GUARD_SITE_NOINLINE
+BasicSemaphoreGuard<A, T, S, L>::BasicSemaphoreGuard(SemaphoreHandle_t handle)
+    : m_handle(handle), m_taken(false), m_deadlineExpired(false) {
+    if (!usable()) {
+        return;
+    }
+    acquire(portMAX_DELAY, callSite(__builtin_return_address(0)));
+}
+
+template <typename A, typename T, typename S, typename L>
+SEMAPHORE_GUARD_SITE_NOINLINE
+BasicSemaphoreGuard<A, T, S, L>::BasicSemaphoreGuard(SemaphoreHandle_t handle, TickType_t timeout)
+    : m_handle(handle), m_taken(false), m_deadlineExpired(false) {
+    if (!usable()) {
+        return;
+    }
+    acquire(timeout, callSite(__builtin_return_address(0)));
+}
+
+template <typename A, typename T, typename S, typename L>
+SEMAPHORE_GUARD_SITE_NOINLINE
+BasicSemaphoreGuard<A, T, S, L>::BasicSemaphoreGuard(SemaphoreHandle_t handle, const Deadline& deadline)
+    : m_handle(handle), m_taken(false), m_deadlineExpired(false) {
+    if (!usable()) {
+        return;
+    }
+    // An expired deadline still allows one non-blocking attempt
+    acquire(deadline.remaining(), callSite(__builtin_return_address(0)));
+    m_deadlineExpired = !m_taken && !deadline.isInfinite();
+}
+
+template <typename A, typename T, typename S, typename L>
+BasicSemaphoreGuard<A, T, S, L>::~BasicSemaphoreGuard() {
+    if (m_taken && m_handle != nullptr) {
+        release();
+    }
+}
+
+template <typename A, typename T, typename S, typename L>
+void BasicSemaphoreGuard<A, T, S, L>::unlock() {
+    if (m_taken && m_handle != nullptr) {
+        release();
+    }
+}
+
+template <typename A, typename T, typename S, typename L>
+SEMAPHORE_GUARD_SITE_NOINLINE
+bool BasicSemaphoreGuard<A, T, S, L>::lock(TickType_t timeout) {
+    if (m_taken || !usable()) {
+        return m_taken;
+    }
+    m_deadlineExpired = false;
+    acquire(timeout, callSite(__builtin_return_address(0)));
+    return m_taken;
+}
+
+template <typename A, typename T, typename S, typename L>
+SEMAPHORE_GUARD_SITE_NOINLINE
+bool BasicSemaphoreGuard<A, T, S, L>::yieldIfContended(TickType_t timeout) {
+    if (!hasWaiters()) {
+        return m_taken;
+    }
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+    if (m_nested) {
+        // An outer guard holds the mutex; giving this count frees nothing
+        return m_taken;
+    }
+#endif
+    const uint32_t waiting = SemaphoreWaiters::count(m_handle);
+    release();
+    // A nested recursive guard's give leaves the mutex with its outer guard
+    if (!AcquireTakesRecursively<A>::value ||
+        xSemaphoreGetMutexHolder(m_handle) != xTaskGetCurrentTaskHandle()) {
+        SemaphoreWaiters::awaitHandOff(m_handle, waiting);
+    }
+    acquire(timeout, callSite(__builtin_return_address(0)));
+    return m_taken;
+}
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+template <typename A, typename T, typename S, typename L>
+SEMAPHORE_GUARD_SITE_NOINLINE
+BasicSemaphoreGuard<A, T, S, L>::BasicSemaphoreGuard(SemaphoreHandle_t handle, const char* file, int line)
+    : m_handle(handle), m_taken(false), m_deadlineExpired(false), m_file(file), m_line(line) {
+    if (!usable()) {
+        return;
+    }
+    L::attempt(m_file, m_line);
+    acquire(portMAX_DELAY, callSite(__builtin_return_address(0)));
+    if (m_taken) {
+        L::acquired(m_file, m_line);
+    }
+}
+
+template <typename A, typename T, typename S, typename L>
+SEMAPHORE_GUARD_SITE_NOINLINE
+BasicSemaphoreGuard<A, T, S, L>::BasicSemaphoreGuard(SemaphoreHandle_t handle, TickType_t timeout,
+                                                     const char* file, int line)
+    : m_handle(handle), m_taken(false), m_deadlineExpired(false), m_file(file), m_line(line) {
+    if (!usable()) {
+        return;
+    }
+    L::attemptTimeout(timeout, m_file, m_line);
+    acquire(timeout, callSite(__builtin_return_address(0)));
+    if (m_taken) {
+        L::acquired(m_file, m_line);
+    } else {
+        L::timedOut(m_file, m_line);
+    }
+}
+
+template <typename A, typename T, typename S, typename L>
+SEMAPHORE_GUARD_SITE_NOINLINE
+BasicSemaphoreGuard<A, T, S, L>::BasicSemaphoreGuard(SemaphoreHandle_t handle, const Deadline& deadline,
+                                                     const char* file, int line)
+    : m_handle(handle), m_taken(false), m_deadlineExpired(false), m_file(file), m_line(line) {
+    if (!usable()) {
+        return;
+    }
+    const TickType_t remaining = deadline.remaining();
+    L::attemptDeadline(remaining, m_file, m_line);
+    acquire(remaining, callSite(__builtin_return_address(0)));
+    m_deadlineExpired = !m_taken && !deadline.isInfinite();
+    if (m_taken) {
+        L::acquired(m_file, m_line);
+    } else {
+        L::deadlineExpired(m_file, m_line);
+    }
+}
+#endif
+
+template <typename A, typename T, typename S, typename L>
+bool BasicSemaphoreGuard<A, T, S, L>::usable() {
+#if SEMAPHORE_GUARD_VALIDATION == 0
+    return true;
+#elif SEMAPHORE_GUARD_VALIDATION == 1
+    configASSERT(m_handle != nullptr);
+    configASSERT(!xPortInIsrContext());
+    return true;
+#else
+    // Check for null handle
+    if (m_handle == nullptr) {
+#ifdef SEMAPHORE_GUARD_DEBUG
+        if (m_file != nullptr) {
+            L::nullHandle(m_file, m_line);
+            return false;
+        }
+#endif
+        L::nullHandle();
+        return false;
+    }
+
+    // Check if we're in ISR context (FreeRTOS restriction)
+    if (xPortInIsrContext()) {
+#ifdef SEMAPHORE_GUARD_DEBUG
+        if (m_file != nullptr) {
+            L::inIsr(m_file, m_line);
+            return false;
+        }
+#endif
+        L::inIsr();
+        return false;
+    }
+    return true;
+#endif
+}
+
+template <typename A, typename T, typename S, typename L>
+GuardSite BasicSemaphoreGuard<A, T, S, L>::callSite(const void* caller) const {
+#ifdef SEMAPHORE_GUARD_DEBUG
+    return GuardSite{m_file, m_line, caller};
+#else
+    return GuardSite{nullptr, 0, caller};
+#endif
+}
+
+template <typename A, typename T, typename S, typename L>
+inline void BasicSemaphoreGuard<A, T, S, L>::acquire(TickType_t timeout, const GuardSite& site) {
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+    // Re-entry by the owning task: count it, the kernel already knows
+    if (AcquireTakesRecursively<A>::value) {
+        m_owner = RecursiveOwnership::find(m_handle);
+        m_nested = m_owner != nullptr;
+        if (m_nested) {
+            RecursiveOwnership::enter(*m_owner);
+            T::markAcquired();
+            m_taken = true;
+            return;
+        }
+    }
+#endif
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+    if (!AcquireTakesRecursively<A>::value && HeldList::wouldSelfDeadlock(m_handle, site)) {
+        m_taken = false;
+        return;
+    }
+#endif
+    S::onAcquireStart(m_handle);
+    m_taken = A::take(m_handle, timeout);
+    if (m_taken) {
+        T::markAcquired();
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+        HeldList::push(m_held, m_handle, site);
+#endif
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+        if (AcquireTakesRecursively<A>::value) {
+            RecursiveOwnership::push(m_node, m_handle);
+            m_owner = &m_node;
+        }
+#endif
+    }
+    S::onAcquireEnd(m_handle, m_taken, site);
+}
+
+template <typename A, typename T, typename S, typename L>
+void BasicSemaphoreGuard<A, T, S, L>::release() {
+#ifdef SEMAPHORE_GUARD_DEBUG
+    if (m_file != nullptr) {
+        L::releasing(m_file, m_line, T::heldTicks());
+    }
+#endif
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+    if (m_nested) {
+        // Normally an outer guard still holds the mutex; if it was
+        // unlocked first, the last nested guard gives it back
+        m_taken = false;
+        m_nested = false;
+        if (RecursiveOwnership::leave(*m_owner)) {
+            A::give(m_handle);
+        }
+        return;
+    }
+#endif
+    S::onRelease(m_handle);
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+    HeldList::remove(m_held);
+#endif
+    m_taken = false;
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+    if (AcquireTakesRecursively<A>::value && !RecursiveOwnership::leave(m_node)) {
+        return;  // Unlocked while nested guards still hold the mutex
+    }
+#endif
+    A::give(m_handle);
+}
+
+// Guard type matching a handle type: RecursiveSemaphoreGuard for
+// RecursiveMutexHandle, SemaphoreGuard for everything else
+template <typename Handle>
+using SemaphoreGuardFor = BasicSemaphoreGuard<
+    typename SemaphoreHandleTraits<typename std::decay<Handle>::type>::Acquire,
+    DefaultTimingPolicy, DefaultStatsPolicy,
+    typename SemaphoreHandleTraits<typename std::decay<Handle>::type>::Log>;
+
+#endif  // _BASIC_SEMAPHORE_GUARD_H_
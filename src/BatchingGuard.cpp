@@ -0,0 +1,59 @@
+#include "BatchingGuard.h"
+
+BatchingGuard::BatchingGuard(SemaphoreHandle_t handle, uint32_t maxOps, TickType_t maxHold, TickType_t timeout)
+    : m_guard(handle, timeout), m_timeout(timeout), m_maxOps(maxOps), m_maxHold(maxHold),
+      m_ops(0), m_takenAt(xTaskGetTickCount()),
+      m_seenWaiters(SemaphoreWaiters::count(handle)), m_handoffs(0) {}
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+BatchingGuard::BatchingGuard(SemaphoreHandle_t handle, uint32_t maxOps, TickType_t maxHold, TickType_t timeout,
+                             const char* file, int line)
+    : m_guard(handle, timeout, file, line), m_timeout(timeout), m_maxOps(maxOps), m_maxHold(maxHold),
+      m_ops(0), m_takenAt(xTaskGetTickCount()),
+      m_seenWaiters(SemaphoreWaiters::count(handle)), m_handoffs(0) {}
+#endif
+
+bool BatchingGuard::next() {
+    if (!m_guard.hasLock()) {
+        // The last take failed; try again
+        if (!m_guard.isValid() || !m_guard.lock(m_timeout)) {
+            return false;
+        }
+        m_ops = 0;
+        m_takenAt = xTaskGetTickCount();
+        m_seenWaiters = SemaphoreWaiters::count(m_guard.getHandle());
+    } else if (batchUsedUp()) {
+        handOff();
+        if (!m_guard.hasLock()) {
+            return false;
+        }
+    }
+    m_ops++;
+    return true;
+}
+
+bool BatchingGuard::batchUsedUp() {
+    if (m_ops >= m_maxOps) {
+        return true;
+    }
+    if (m_maxHold != portMAX_DELAY && xTaskGetTickCount() - m_takenAt >= m_maxHold) {
+        return true;
+    }
+    const uint32_t waiting = SemaphoreWaiters::count(m_guard.getHandle());
+    if (waiting < m_seenWaiters) {
+        m_seenWaiters = waiting;
+    }
+    return waiting > m_seenWaiters || (waiting > 0 && m_ops >= SEMAPHORE_GUARD_BATCH_MIN_OPS);
+}
+
+void BatchingGuard::handOff() {
+    const SemaphoreHandle_t handle = m_guard.getHandle();
+    const uint32_t waiting = SemaphoreWaiters::count(handle);
+    m_guard.unlock();
+    SemaphoreWaiters::awaitHandOff(handle, waiting);
+    m_guard.lock(m_timeout);
+    m_seenWaiters = SemaphoreWaiters::count(handle);
+    m_handoffs++;
+    m_ops = 0;
+    m_takenAt = xTaskGetTickCount();
+}
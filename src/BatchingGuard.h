@@ -0,0 +1,102 @@
+#ifndef _BATCHING_GUARD_H_
+#define _BATCHING_GUARD_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "SemaphoreGuard.h"
+#include "SemaphoreWaiters.h"
+
+// Operations between hand-offs to waiters that were already there at the
+// last hand-off
+#ifndef SEMAPHORE_GUARD_BATCH_MIN_OPS
+#define SEMAPHORE_GUARD_BATCH_MIN_OPS 8
+#endif
+
+// RAII guard that keeps a semaphore across a batch of small operations.
+//
+// Taking a mutex for every 8-byte update costs a kernel take and give each
+// time. A BatchingGuard takes it once and keeps it while next() is called
+// before each operation. It hands the lock over, with a release, a yield
+// and a re-take, when any of these happens:
+//   - maxOps operations have run since the last take
+//   - maxHold ticks have passed since the last take (portMAX_DELAY: no limit)
+//   - a guard is blocked on the semaphore (SemaphoreWaiters)
+// Other tasks therefore wait at most one batch, and at once when they
+// queue up behind a guard. Waiters still counted after a hand-off may be
+// guards on another semaphore in the same bucket, which never take this
+// one; they end the batch only every SEMAPHORE_GUARD_BATCH_MIN_OPS
+// operations, and new waiters end it at once.
+//
+//     BatchingGuard batch(xDataMutex, 64, pdMS_TO_TICKS(2));
+//     while (readSample(&sample)) {
+//         if (!batch.next()) {
+//             break;  // Re-take timed out
+//         }
+//         counters[sample.id] += sample.value;
+//     }
+class BatchingGuard {
+public:
+    // Constructor: Takes the semaphore; re-takes wait up to timeout
+    BatchingGuard(SemaphoreHandle_t handle, uint32_t maxOps, TickType_t maxHold,
+                  TickType_t timeout = portMAX_DELAY);
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+    // Debug constructor with file/line info
+    BatchingGuard(SemaphoreHandle_t handle, uint32_t maxOps, TickType_t maxHold, TickType_t timeout,
+                  const char* file, int line);
+#endif
+
+    // Destructor: m_guard gives the semaphore back
+
+    // Delete copy constructor and copy assignment to prevent double-release
+    BatchingGuard(const BatchingGuard&) = delete;
+    BatchingGuard& operator=(const BatchingGuard&) = delete;
+
+    // Delete move constructor and move assignment for safety
+    BatchingGuard(BatchingGuard&&) = delete;
+    BatchingGuard& operator=(BatchingGuard&&) = delete;
+
+    // Call before each operation: hands the lock over if the batch is
+    // used up or someone waits, and retries a failed take; returns hasLock()
+    bool next();
+
+    // Check if the semaphore is currently held
+    [[nodiscard]] bool hasLock() const noexcept { return m_guard.hasLock(); }
+
+    // Get the semaphore handle (for advanced use cases)
+    [[nodiscard]] SemaphoreHandle_t getHandle() const noexcept { return m_guard.getHandle(); }
+
+    // Check if this guard is valid (has non-null handle)
+    [[nodiscard]] bool isValid() const noexcept { return m_guard.isValid(); }
+
+    // Times the lock was handed over so far
+    [[nodiscard]] uint32_t handoffs() const noexcept { return m_handoffs; }
+
+    // Operations run under the current take
+    [[nodiscard]] uint32_t batchOps() const noexcept { return m_ops; }
+
+private:
+    bool batchUsedUp();
+    void handOff();
+
+    SemaphoreGuard m_guard;
+    TickType_t m_timeout;     // For re-takes
+    uint32_t m_maxOps;
+    TickType_t m_maxHold;
+    uint32_t m_ops;           // Operations since the last take
+    TickType_t m_takenAt;     // Tick count at the last take
+    uint32_t m_seenWaiters;   // Waiters counted at the last take
+    uint32_t m_handoffs;
+};
+
+// Macro for debug support
+#ifdef SEMAPHORE_GUARD_DEBUG
+    #define BATCHING_GUARD(handle, maxOps, maxHold) \
+        BatchingGuard guard(handle, maxOps, maxHold, portMAX_DELAY, __FILE__, __LINE__)
+#else
+    #define BATCHING_GUARD(handle, maxOps, maxHold) BatchingGuard guard(handle, maxOps, maxHold)
+#endif
+
+#endif  // _BATCHING_GUARD_H_
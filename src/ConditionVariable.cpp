@@ -0,0 +1,134 @@
+#include "ConditionVariable.h"
+#include "CriticalSectionGuard.h"
+
+ConditionVariable::ConditionVariable() : m_head(nullptr), m_tail(nullptr), m_count(0) {
+    portMUX_INITIALIZE(&m_mux);
+}
+
+bool ConditionVariable::checkHeld(bool held) {
+    if (!held) {
+        CV_LOG_E("wait() called without holding the guard's lock");
+    }
+    return held;
+}
+
+void ConditionVariable::enqueue(Waiter& waiter) {
+    waiter.task = xTaskGetCurrentTaskHandle();
+    waiter.next = nullptr;
+    waiter.notified = false;
+
+    CriticalSectionGuard guard(&m_mux);
+    waiter.prev = m_tail;
+    if (m_tail != nullptr) {
+        m_tail->next = &waiter;
+    } else {
+        m_head = &waiter;
+    }
+    m_tail = &waiter;
+    m_count++;
+}
+
+bool ConditionVariable::block(Waiter& waiter, TickType_t timeout) {
+    const TickType_t start = xTaskGetTickCount();
+    TickType_t wait = timeout;
+    bool signalled = false;  // The notifier's SEMAPHORE_GUARD_CV_NOTIFY_BIT arrived
+    while (true) {
+        // A signal sent between enqueue() and here is kept pending by the
+        // kernel, so this returns immediately instead of losing it
+        uint32_t value = 0;
+        if (xTaskNotifyWait(0, UINT32_MAX, &value, wait) == pdTRUE &&
+            (value & SEMAPHORE_GUARD_CV_NOTIFY_BIT) != 0) {
+            signalled = true;
+        }
+
+        // notifyOne()/notifyAll() mark the waiter before they signal it
+        bool notified;
+        bool expired = false;
+        {
+            CriticalSectionGuard guard(&m_mux);
+            notified = waiter.notified;
+            if (!notified && timeout != portMAX_DELAY) {
+                const TickType_t elapsed = xTaskGetTickCount() - start;
+                expired = elapsed >= timeout;
+                wait = expired ? 0 : timeout - elapsed;
+                if (expired) {
+                    unlink(waiter);
+                }
+            }
+        }
+
+        if (notified) {
+            if (signalled) {
+                return true;
+            }
+            // Marked, but woken by some other give or by the timeout: the
+            // notifier's signal is on its way. Wait for it, so it cannot end
+            // a later wait and the notifier never signals a returned waiter
+            wait = portMAX_DELAY;
+            continue;
+        }
+        // Not marked, so the bit was not ours
+        signalled = false;
+        if (expired) {
+            return false;
+        }
+    }
+}
+
+void ConditionVariable::unlink(Waiter& waiter) {
+    if (waiter.prev != nullptr) {
+        waiter.prev->next = waiter.next;
+    } else {
+        m_head = waiter.next;
+    }
+    if (waiter.next != nullptr) {
+        waiter.next->prev = waiter.prev;
+    } else {
+        m_tail = waiter.prev;
+    }
+    m_count--;
+}
+
+void ConditionVariable::notifyOne() {
+    TaskHandle_t task = nullptr;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        Waiter* waiter = m_head;
+        if (waiter == nullptr) {
+            return;
+        }
+        unlink(*waiter);
+        waiter->notified = true;
+        task = waiter->task;
+    }
+    xTaskNotify(task, SEMAPHORE_GUARD_CV_NOTIFY_BIT, eSetBits);
+}
+
+void ConditionVariable::notifyAll() {
+    // Detach the whole list, then wake each task outside the critical section
+    Waiter* list;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        list = m_head;
+        m_head = nullptr;
+        m_tail = nullptr;
+        m_count = 0;
+        for (Waiter* waiter = list; waiter != nullptr; waiter = waiter->next) {
+            waiter->notified = true;
+        }
+    }
+
+    while (list != nullptr) {
+        // A marked waiter stays in wait() until its own signal arrives, so
+        // the records not yet signalled are still alive. Read next before
+        // signalling: this one may return as soon as it runs
+        Waiter* next = list->next;
+        xTaskNotify(list->task, SEMAPHORE_GUARD_CV_NOTIFY_BIT, eSetBits);
+        list = next;
+    }
+}
+
+size_t ConditionVariable::waiters() const {
+    CriticalSectionGuard guard(&m_mux);
+    return m_count;
+}
@@ -0,0 +1,130 @@
+#ifndef _CONDITION_VARIABLE_H_
+#define _CONDITION_VARIABLE_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "Deadline.h"
+
+// Bit of the waiting task's notification value that notifyOne() and
+// notifyAll() set. Plain xTaskNotifyGive() increments the value and so
+// never reaches it
+#ifndef SEMAPHORE_GUARD_CV_NOTIFY_BIT
+#define SEMAPHORE_GUARD_CV_NOTIFY_BIT 0x80000000UL
+#endif
+
+// Condition variable for tasks waiting on state protected by a guard.
+//
+//     SEMAPHORE_GUARD(xQueueMutex);
+//     gDataReady.wait(guard, [] { return !gQueue.empty(); });
+//     // Lock held, predicate true
+//
+//     // Producer
+//     {
+//         SEMAPHORE_GUARD(xQueueMutex);
+//         gQueue.push(item);
+//     }
+//     gDataReady.notifyOne();
+//
+// wait() atomically queues the task and releases the guard, blocks on the
+// task's notification and re-takes the guard before returning. Waiter
+// records live on the waiting task's stack; nothing is allocated.
+//
+// Uses the default task notification slot of waiting tasks: the notifier
+// sets SEMAPHORE_GUARD_CV_NOTIFY_BIT. A wait only ends on that bit after
+// notifyOne()/notifyAll() picked the task, or on its timeout. A wake-up by
+// some other xTaskNotifyGive() is recognised and the wait continues, and
+// the notifier's own signal is always consumed by the wait it was meant
+// for. Other notifications that arrive during a wait are consumed too, so
+// tasks should not rely on them while they wait here. Works with any guard offering hasLock(), unlock() and lock();
+// a recursive mutex must be held only once while waiting.
+class ConditionVariable {
+public:
+    ConditionVariable();
+
+    // Delete copy and move; waiters refer to this instance
+    ConditionVariable(const ConditionVariable&) = delete;
+    ConditionVariable& operator=(const ConditionVariable&) = delete;
+    ConditionVariable(ConditionVariable&&) = delete;
+    ConditionVariable& operator=(ConditionVariable&&) = delete;
+
+    // Block until notified. The state may still have changed again before
+    // the lock is re-taken; prefer the predicate form
+    template <typename Guard>
+    void wait(Guard& guard) {
+        waitFor(guard, portMAX_DELAY);
+    }
+
+    // Block until pred() returns true
+    template <typename Guard, typename Predicate>
+    void wait(Guard& guard, Predicate pred) {
+        waitUntil(guard, Deadline::never(), pred);
+    }
+
+    // Block until notified or timeout ticks pass. Returns false on timeout.
+    // The guard holds the lock again on return either way
+    template <typename Guard>
+    bool waitFor(Guard& guard, TickType_t timeout) {
+        if (!checkHeld(guard.hasLock())) {
+            return false;
+        }
+        Waiter waiter;
+        enqueue(waiter);
+        guard.unlock();
+        const bool notified = block(waiter, timeout);
+        guard.lock(portMAX_DELAY);
+        return notified;
+    }
+
+    // Block until pred() returns true or timeout ticks pass; returns pred()
+    template <typename Guard, typename Predicate>
+    bool waitFor(Guard& guard, TickType_t timeout, Predicate pred) {
+        return waitUntil(guard, Deadline(timeout), pred);
+    }
+
+    // Block until pred() returns true or the deadline passes; returns pred()
+    template <typename Guard, typename Predicate>
+    bool waitUntil(Guard& guard, const Deadline& deadline, Predicate pred) {
+        if (!checkHeld(guard.hasLock())) {
+            return false;
+        }
+        while (!pred()) {
+            const TickType_t remaining = deadline.remaining();
+            if (remaining == 0) {
+                return false;
+            }
+            waitFor(guard, remaining);
+        }
+        return true;
+    }
+
+    // Wake the longest-waiting task, if any
+    void notifyOne();
+
+    // Wake every waiting task
+    void notifyAll();
+
+    // Tasks currently waiting
+    [[nodiscard]] size_t waiters() const;
+
+private:
+    struct Waiter {
+        TaskHandle_t task;
+        Waiter* next;
+        Waiter* prev;
+        bool notified;
+    };
+
+    static bool checkHeld(bool held);
+    void enqueue(Waiter& waiter);
+    bool block(Waiter& waiter, TickType_t timeout);
+    void unlink(Waiter& waiter);
+
+    Waiter* m_head;  // FIFO of waiting tasks, guarded by m_mux
+    Waiter* m_tail;
+    size_t m_count;
+    mutable portMUX_TYPE m_mux;
+};
+
+#endif  // _CONDITION_VARIABLE_H_
@@ -0,0 +1,166 @@
+#include "ContentionProfiler.h"
+#include "CriticalSectionGuard.h"
+#include <string.h>
+
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Guarded by s_mux
+static ContentionSite s_sites[SEMAPHORE_GUARD_PROFILE_SITES];
+static size_t s_used = 0;
+static uint32_t s_samples = 0;
+static uint32_t s_rng = 0x9E3779B9;
+
+static volatile uint32_t s_period = SEMAPHORE_GUARD_SAMPLE_PERIOD;
+
+uint32_t ContentionProfiler::s_countdown[portNUM_PROCESSORS] = {};
+
+void ContentionProfiler::setPeriod(uint32_t period) {
+    s_period = period;
+    // Take effect at each core's next acquisition
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        s_countdown[core] = 0;
+    }
+}
+
+uint32_t ContentionProfiler::period() {
+    return s_period;
+}
+
+bool ContentionProfiler::rearm(uint32_t& countdown) {
+    const uint32_t period = s_period;
+    if (period == 0) {
+        countdown = UINT32_MAX;  // Disabled: back here only after setPeriod()
+        return false;
+    }
+    if (period == 1) {
+        countdown = 1;
+        return true;
+    }
+
+    // Uniform in [period / 2, period * 3 / 2): the mean stays at period
+    uint32_t random;
+    {
+        CriticalSectionGuard guard(&s_mux);
+        s_rng ^= s_rng << 13;
+        s_rng ^= s_rng >> 17;
+        s_rng ^= s_rng << 5;
+        random = s_rng;
+    }
+    countdown = period / 2 + random % period;
+    return true;
+}
+
+static bool sameSite(const ContentionSite& entry, const GuardSite& site) {
+    return entry.caller == site.caller && entry.file == site.file && entry.line == site.line;
+}
+
+void ContentionProfiler::record(const GuardSite& site, SemaphoreHandle_t handle, bool taken,
+                                uint32_t waitUs, uint32_t holdUs) {
+    CriticalSectionGuard guard(&s_mux);
+    s_samples++;
+
+    ContentionSite* entry = nullptr;
+    for (size_t i = 0; i < s_used; i++) {
+        if (sameSite(s_sites[i], site)) {
+            entry = &s_sites[i];
+            break;
+        }
+    }
+
+    if (entry == nullptr) {
+        uint64_t inherited = 0;
+        if (s_used < SEMAPHORE_GUARD_PROFILE_SITES) {
+            entry = &s_sites[s_used++];
+        } else {
+            // Replace the lightest site; the newcomer starts at its weight
+            entry = &s_sites[0];
+            for (size_t i = 1; i < s_used; i++) {
+                if (s_sites[i].weight < entry->weight) {
+                    entry = &s_sites[i];
+                }
+            }
+            inherited = entry->weight;
+        }
+        memset(entry, 0, sizeof(*entry));
+        entry->file = site.file;
+        entry->line = site.line;
+        entry->caller = site.caller;
+        entry->weight = inherited;
+    }
+
+    entry->handle = handle;
+    entry->samples++;
+    if (!taken) {
+        entry->timeouts++;
+    }
+    entry->totalWaitUs += waitUs;
+    entry->totalHoldUs += holdUs;
+    if (waitUs > entry->maxWaitUs) {
+        entry->maxWaitUs = waitUs;
+    }
+    if (holdUs > entry->maxHoldUs) {
+        entry->maxHoldUs = holdUs;
+    }
+    entry->weight += static_cast<uint64_t>(waitUs) + holdUs;
+}
+
+size_t ContentionProfiler::snapshot(ContentionSite* out, size_t maxSites) {
+    ContentionSite copy[SEMAPHORE_GUARD_PROFILE_SITES];
+    size_t count;
+    {
+        CriticalSectionGuard guard(&s_mux);
+        count = s_used;
+        memcpy(copy, s_sites, count * sizeof(ContentionSite));
+    }
+
+    // Selection sort, heaviest first; the table is small
+    size_t copied = 0;
+    for (; copied < maxSites && copied < count; copied++) {
+        size_t heaviest = copied;
+        for (size_t i = copied + 1; i < count; i++) {
+            if (copy[i].weight > copy[heaviest].weight) {
+                heaviest = i;
+            }
+        }
+        const ContentionSite swap = copy[copied];
+        copy[copied] = copy[heaviest];
+        copy[heaviest] = swap;
+        out[copied] = copy[copied];
+    }
+    return copied;
+}
+
+void ContentionProfiler::report(size_t maxSites) {
+    ContentionSite sites[SEMAPHORE_GUARD_PROFILE_SITES];
+    const size_t count = snapshot(sites, maxSites < SEMAPHORE_GUARD_PROFILE_SITES ? maxSites
+                                                                                 : SEMAPHORE_GUARD_PROFILE_SITES);
+    SAMP_LOG_I("%lu samples, period %lu, heaviest %u sites:",
+               (unsigned long)samples(), (unsigned long)period(), (unsigned)count);
+    for (size_t i = 0; i < count; i++) {
+        const ContentionSite& site = sites[i];
+        const unsigned long avgWait = (unsigned long)(site.totalWaitUs / site.samples);
+        const unsigned long avgHold = (unsigned long)(site.totalHoldUs / site.samples);
+        if (site.file != nullptr) {
+            SAMP_LOG_I("  %s:%d lock %p: %lu samples, wait avg %lu max %lu us, hold avg %lu max %lu us, %lu timeouts",
+                       site.file, site.line, site.handle, (unsigned long)site.samples,
+                       avgWait, (unsigned long)site.maxWaitUs, avgHold, (unsigned long)site.maxHoldUs,
+                       (unsigned long)site.timeouts);
+        } else {
+            SAMP_LOG_I("  %p lock %p: %lu samples, wait avg %lu max %lu us, hold avg %lu max %lu us, %lu timeouts",
+                       site.caller, site.handle, (unsigned long)site.samples,
+                       avgWait, (unsigned long)site.maxWaitUs, avgHold, (unsigned long)site.maxHoldUs,
+                       (unsigned long)site.timeouts);
+        }
+    }
+}
+
+void ContentionProfiler::reset() {
+    CriticalSectionGuard guard(&s_mux);
+    s_used = 0;
+    s_samples = 0;
+}
+
+uint32_t ContentionProfiler::samples() {
+    CriticalSectionGuard guard(&s_mux);
+    return s_samples;
+}
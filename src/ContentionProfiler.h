@@ -0,0 +1,128 @@
+#ifndef _CONTENTION_PROFILER_H_
+#define _CONTENTION_PROFILER_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "GuardSite.h"
+
+// Mean number of acquisitions per sample; 0 disables sampling
+#ifndef SEMAPHORE_GUARD_SAMPLE_PERIOD
+#define SEMAPHORE_GUARD_SAMPLE_PERIOD 64
+#endif
+
+// Call sites tracked at the same time
+#ifndef SEMAPHORE_GUARD_PROFILE_SITES
+#define SEMAPHORE_GUARD_PROFILE_SITES 16
+#endif
+
+// Accumulated samples of one call site
+struct ContentionSite {
+    const char* file;           // Debug builds; nullptr otherwise
+    int line;
+    const void* caller;         // Return address of the guard constructor
+    SemaphoreHandle_t handle;   // Lock most recently sampled at this site
+    uint32_t samples;
+    uint32_t timeouts;          // Sampled acquisitions that failed
+    uint64_t totalWaitUs;
+    uint32_t maxWaitUs;
+    uint64_t totalHoldUs;
+    uint32_t maxHoldUs;
+    uint64_t weight;            // Ranking key: wait + hold, plus the estimate inherited on eviction
+};
+
+// Sampling contention profiler for always-on production use.
+//
+// Guards with the SamplingStats policy measure only one acquisition in
+// about SEMAPHORE_GUARD_SAMPLE_PERIOD. The choice is a per-core countdown,
+// re-armed with a random interval after each sample so periodic code
+// cannot alias with it. An unsampled acquisition costs one core-ID read,
+// a decrement and two not-taken branches.
+//
+// Sampled acquisitions record wait and hold time in microseconds
+// (esp_timer, which stays consistent if the task moves between cores) into
+// a table of the SEMAPHORE_GUARD_PROFILE_SITES heaviest call sites. When
+// the table is full, a new site replaces the lightest one and inherits its
+// weight (the Space-Saving heavy-hitters scheme), so a site that keeps
+// showing up cannot be crowded out by one-off sites.
+//
+//     ContentionProfiler::report();   // Log the heaviest sites
+class ContentionProfiler {
+public:
+    // Change the mean sampling period; 0 stops sampling
+    static void setPeriod(uint32_t period);
+    [[nodiscard]] static uint32_t period();
+
+    // Copy up to maxSites sites, heaviest first; returns the number copied
+    static size_t snapshot(ContentionSite* out, size_t maxSites);
+
+    // Log the heaviest sites
+    static void report(size_t maxSites = 8);
+
+    // Forget all sites
+    static void reset();
+
+    // Acquisitions sampled since the last reset
+    [[nodiscard]] static uint32_t samples();
+
+    // Decide whether the calling acquisition is sampled
+    static bool shouldSample() {
+        uint32_t& countdown = s_countdown[xPortGetCoreID()];
+        if (countdown > 1) {
+            countdown--;
+            return false;
+        }
+        return rearm(countdown);
+    }
+
+    // Add one sampled acquisition
+    static void record(const GuardSite& site, SemaphoreHandle_t handle, bool taken,
+                       uint32_t waitUs, uint32_t holdUs);
+
+private:
+    static bool rearm(uint32_t& countdown);
+
+    // Per-core countdown; tasks on the same core may race on it, which only
+    // shifts a sample by an acquisition
+    static uint32_t s_countdown[portNUM_PROCESSORS];  // Defined in ContentionProfiler.cpp
+};
+
+// Stats policy that feeds ContentionProfiler
+struct SamplingStats {
+    void onAcquireStart(SemaphoreHandle_t) {
+        m_sampled = ContentionProfiler::shouldSample();
+        if (m_sampled) {
+            m_mark = static_cast<uint32_t>(esp_timer_get_time());
+        }
+    }
+    void onAcquireEnd(SemaphoreHandle_t handle, bool taken, const GuardSite& site) {
+        if (!m_sampled) {
+            return;
+        }
+        const uint32_t now = static_cast<uint32_t>(esp_timer_get_time());
+        m_wait = now - m_mark;
+        m_mark = now;
+        m_site = site;
+        if (!taken) {
+            ContentionProfiler::record(site, handle, false, m_wait, 0);
+            m_sampled = false;
+        }
+    }
+    void onRelease(SemaphoreHandle_t handle) {
+        if (!m_sampled) {
+            return;
+        }
+        const uint32_t hold = static_cast<uint32_t>(esp_timer_get_time()) - m_mark;
+        ContentionProfiler::record(m_site, handle, true, m_wait, hold);
+        m_sampled = false;
+    }
+
+    bool m_sampled = false;
+    uint32_t m_mark = 0;  // Start of the wait, then time of acquisition
+    uint32_t m_wait = 0;
+    GuardSite m_site = {nullptr, 0, nullptr};
+};
+
+#endif  // _CONTENTION_PROFILER_H_
@@ -0,0 +1,52 @@
+#include "CriticalSectionGuard.h"
+#include <esp_attr.h>
+
+static std::atomic<uint32_t> s_sections(0);
+static std::atomic<uint32_t> s_maxCycles(0);
+static std::atomic<uint32_t> s_overBudget(0);
+
+// Called from IsrCriticalSectionGuard as well, so keep it in IRAM
+IRAM_ATTR void criticalSectionRecord(uint32_t cycles, bool fromIsr, const char* file, int line) {
+    s_sections.fetch_add(1, std::memory_order_relaxed);
+
+    uint32_t seen = s_maxCycles.load(std::memory_order_relaxed);
+    while (cycles > seen &&
+           !s_maxCycles.compare_exchange_weak(seen, cycles, std::memory_order_relaxed)) {
+    }
+
+#ifdef CRITICAL_SECTION_BUDGET_CYCLES
+    if (cycles > (uint32_t)(CRITICAL_SECTION_BUDGET_CYCLES)) {
+        s_overBudget.fetch_add(1, std::memory_order_relaxed);
+        // Logging is not allowed from an interrupt handler; the counter
+        // above is the only trace of ISR-side violations
+        if (!fromIsr) {
+            if (file != nullptr) {
+                CSG_LOG_W("Interrupts disabled for %lu cycles (budget %lu) at %s:%d",
+                          (unsigned long)cycles, (unsigned long)(CRITICAL_SECTION_BUDGET_CYCLES),
+                          file, line);
+            } else {
+                CSG_LOG_W("Interrupts disabled for %lu cycles (budget %lu)",
+                          (unsigned long)cycles, (unsigned long)(CRITICAL_SECTION_BUDGET_CYCLES));
+            }
+        }
+    }
+#else
+    (void)fromIsr;
+    (void)file;
+    (void)line;
+#endif
+}
+
+CriticalSectionStats criticalSectionGetStats() {
+    CriticalSectionStats stats;
+    stats.sections = s_sections.load(std::memory_order_relaxed);
+    stats.maxCycles = s_maxCycles.load(std::memory_order_relaxed);
+    stats.overBudget = s_overBudget.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void criticalSectionResetStats() {
+    s_sections.store(0, std::memory_order_relaxed);
+    s_maxCycles.store(0, std::memory_order_relaxed);
+    s_overBudget.store(0, std::memory_order_relaxed);
+}
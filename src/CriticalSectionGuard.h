@@ -0,0 +1,203 @@
+#ifndef _CRITICAL_SECTION_GUARD_H_
+#define _CRITICAL_SECTION_GUARD_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+
+// Define CRITICAL_SECTION_BUDGET_CYCLES to measure how long each guarded
+// section keeps interrupts disabled and warn when it exceeds the budget.
+// Without it the guards compile down to portENTER/portEXIT_CRITICAL.
+#ifdef CRITICAL_SECTION_BUDGET_CYCLES
+#include "SemaphoreGuardCycles.h"
+#endif
+
+// Interrupt-disabled time statistics, only collected with
+// CRITICAL_SECTION_BUDGET_CYCLES defined
+struct CriticalSectionStats {
+    uint32_t sections;     // Guarded sections measured
+    uint32_t maxCycles;    // Longest interrupt-disabled time seen
+    uint32_t overBudget;   // Sections exceeding CRITICAL_SECTION_BUDGET_CYCLES
+};
+
+// Records one measured section; logs over-budget sections from task context
+void criticalSectionRecord(uint32_t cycles, bool fromIsr, const char* file, int line);
+
+// Snapshot and reset of the global statistics
+CriticalSectionStats criticalSectionGetStats();
+void criticalSectionResetStats();
+
+// RAII guard around a portMUX spinlock, for sections of a few dozen
+// instructions where a FreeRTOS mutex costs more than the work it protects.
+// Interrupts on the current core stay disabled while the guard is alive, so
+// never block, log or call into the scheduler inside the section.
+//
+// Use CriticalSectionGuard from tasks and IsrCriticalSectionGuard from
+// interrupt handlers. The API mirrors SemaphoreGuard so a call site can
+// switch primitives by changing only the type or macro.
+template <bool FromIsr>
+class BasicCriticalSectionGuard {
+public:
+    // Constructor: Spins until the lock is acquired
+    explicit BasicCriticalSectionGuard(portMUX_TYPE* mux)
+        : m_mux(mux), m_taken(false) {
+        if (m_mux == nullptr) {
+            if (!FromIsr) {
+                CSG_LOG_E("Null spinlock provided");
+            }
+            return;
+        }
+        enter();
+    }
+
+    // Constructor: Spins for at most timeoutCycles CPU cycles. Requires
+    // portTRY_ENTER_CRITICAL (ESP-IDF 4.3+); otherwise waits indefinitely
+    BasicCriticalSectionGuard(portMUX_TYPE* mux, BaseType_t timeoutCycles)
+        : m_mux(mux), m_taken(false) {
+        if (m_mux == nullptr) {
+            if (!FromIsr) {
+                CSG_LOG_E("Null spinlock provided");
+            }
+            return;
+        }
+        tryEnter(timeoutCycles);
+    }
+
+    // Destructor: Releases the lock and re-enables interrupts
+    ~BasicCriticalSectionGuard() {
+        if (!m_taken || m_mux == nullptr) {
+            return;
+        }
+#ifdef CRITICAL_SECTION_BUDGET_CYCLES
+        const uint32_t cycles = semgCycleCount() - m_enterCycles;
+#endif
+        if (FromIsr) {
+            portEXIT_CRITICAL_ISR(m_mux);
+        } else {
+            portEXIT_CRITICAL(m_mux);
+        }
+#ifdef CRITICAL_SECTION_BUDGET_CYCLES
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        criticalSectionRecord(cycles, FromIsr, m_file, m_line);
+    #else
+        criticalSectionRecord(cycles, FromIsr, nullptr, 0);
+    #endif
+#endif
+    }
+
+    // Delete copy constructor and copy assignment to prevent double-release
+    BasicCriticalSectionGuard(const BasicCriticalSectionGuard&) = delete;
+    BasicCriticalSectionGuard& operator=(const BasicCriticalSectionGuard&) = delete;
+
+    // Delete move constructor and move assignment for safety
+    BasicCriticalSectionGuard(BasicCriticalSectionGuard&&) = delete;
+    BasicCriticalSectionGuard& operator=(BasicCriticalSectionGuard&&) = delete;
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+    // Debug constructors with file/line info; also verify the calling context
+    BasicCriticalSectionGuard(portMUX_TYPE* mux, const char* file, int line)
+        : m_mux(mux), m_taken(false), m_file(file), m_line(line) {
+        if (!checkContext()) {
+            return;
+        }
+        enter();
+    }
+
+    BasicCriticalSectionGuard(portMUX_TYPE* mux, BaseType_t timeoutCycles, const char* file, int line)
+        : m_mux(mux), m_taken(false), m_file(file), m_line(line) {
+        if (!checkContext()) {
+            return;
+        }
+        tryEnter(timeoutCycles);
+        if (!m_taken) {
+            CSG_LOG_W("Failed to acquire spinlock within %ld cycles at %s:%d",
+                      (long)timeoutCycles, m_file, m_line);
+        }
+    }
+#endif
+
+    // Check if the spinlock was successfully acquired
+    [[nodiscard]] bool hasLock() const noexcept { return m_taken; }
+
+    // Get the spinlock (for advanced use cases)
+    [[nodiscard]] portMUX_TYPE* getHandle() const noexcept { return m_mux; }
+
+    // Check if this guard is valid (has non-null spinlock)
+    [[nodiscard]] bool isValid() const noexcept { return m_mux != nullptr; }
+
+private:
+    void enter() {
+        if (FromIsr) {
+            portENTER_CRITICAL_ISR(m_mux);
+        } else {
+            portENTER_CRITICAL(m_mux);
+        }
+        m_taken = true;
+#ifdef CRITICAL_SECTION_BUDGET_CYCLES
+        m_enterCycles = semgCycleCount();
+#endif
+    }
+
+    void tryEnter(BaseType_t timeoutCycles) {
+#ifdef portTRY_ENTER_CRITICAL
+        // Same call for task and ISR context on ESP-IDF
+        m_taken = (portTRY_ENTER_CRITICAL(m_mux, timeoutCycles) == pdPASS);
+    #ifdef CRITICAL_SECTION_BUDGET_CYCLES
+        m_enterCycles = semgCycleCount();
+    #endif
+#else
+        (void)timeoutCycles;
+        enter();
+#endif
+    }
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+    bool checkContext() const {
+        if (m_mux == nullptr) {
+            if (!FromIsr) {
+                CSG_LOG_E("Null spinlock provided at %s:%d", m_file, m_line);
+            }
+            return false;
+        }
+        if (!FromIsr && xPortInIsrContext()) {
+            CSG_LOG_E("Use IsrCriticalSectionGuard in ISR context at %s:%d", m_file, m_line);
+            return false;
+        }
+        if (FromIsr && !xPortInIsrContext()) {
+            CSG_LOG_E("Use CriticalSectionGuard outside ISR context at %s:%d", m_file, m_line);
+            return false;
+        }
+        return true;
+    }
+#endif
+
+    portMUX_TYPE* m_mux;
+    bool m_taken;  // Indicates whether the spinlock was successfully taken
+
+#ifdef CRITICAL_SECTION_BUDGET_CYCLES
+    uint32_t m_enterCycles;
+#endif
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+    const char* m_file = nullptr;
+    int m_line = 0;
+#endif
+};
+
+typedef BasicCriticalSectionGuard<false> CriticalSectionGuard;
+typedef BasicCriticalSectionGuard<true> IsrCriticalSectionGuard;
+
+// Macro for debug support
+#ifdef SEMAPHORE_GUARD_DEBUG
+    #define CRITICAL_SECTION_GUARD(mux) CriticalSectionGuard guard(mux, __FILE__, __LINE__)
+    #define CRITICAL_SECTION_GUARD_TIMEOUT(mux, cycles) CriticalSectionGuard guard(mux, cycles, __FILE__, __LINE__)
+    #define ISR_CRITICAL_SECTION_GUARD(mux) IsrCriticalSectionGuard guard(mux, __FILE__, __LINE__)
+#else
+    #define CRITICAL_SECTION_GUARD(mux) CriticalSectionGuard guard(mux)
+    #define CRITICAL_SECTION_GUARD_TIMEOUT(mux, cycles) CriticalSectionGuard guard(mux, cycles)
+    #define ISR_CRITICAL_SECTION_GUARD(mux) IsrCriticalSectionGuard guard(mux)
+#endif
+
+#endif  // _CRITICAL_SECTION_GUARD_H_
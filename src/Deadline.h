@@ -0,0 +1,54 @@
+#ifndef _DEADLINE_H_
+#define _DEADLINE_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+// Absolute time budget shared by several lock acquisitions.
+//
+// A request that takes three locks with SemaphoreGuard(handle, timeout) can
+// wait three times its timeout. Passing the same Deadline to each guard
+// instead makes every acquisition use only the time that is left, so the
+// total wait never exceeds the budget.
+//
+// Built on vTaskSetTimeOutState() / xTaskCheckForTimeOut(), which handle
+// tick counter overflow. Cheap to copy; not for use in ISRs.
+class Deadline {
+public:
+    // Budget of the given number of ticks, starting now
+    explicit Deadline(TickType_t budget) : m_budget(budget) {
+        vTaskSetTimeOutState(&m_start);
+    }
+
+    // Convenience factories
+    static Deadline after(TickType_t ticks) { return Deadline(ticks); }
+    static Deadline never() { return Deadline(portMAX_DELAY); }
+
+    // Ticks left before the deadline; portMAX_DELAY if it never expires
+    [[nodiscard]] TickType_t remaining() const {
+        if (m_budget == portMAX_DELAY) {
+            return portMAX_DELAY;
+        }
+        // xTaskCheckForTimeOut() updates both arguments, so work on copies
+        TimeOut_t start = m_start;
+        TickType_t left = m_budget;
+        if (xTaskCheckForTimeOut(&start, &left) == pdTRUE) {
+            return 0;
+        }
+        return left;
+    }
+
+    // Check if the budget is used up
+    [[nodiscard]] bool expired() const { return remaining() == 0; }
+
+    // Check if this deadline never expires
+    [[nodiscard]] bool isInfinite() const noexcept { return m_budget == portMAX_DELAY; }
+
+    // The original budget in ticks
+    [[nodiscard]] TickType_t budget() const noexcept { return m_budget; }
+
+private:
+    TimeOut_t m_start;
+    TickType_t m_budget;
+};
+
+#endif  // _DEADLINE_H_
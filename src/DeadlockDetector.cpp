@@ -0,0 +1,257 @@
+#include "DeadlockDetector.h"
+#include "SemaphoreWaiters.h"
+#include <atomic>
+
+namespace {
+
+// One blocked take. gen changes with every registration, so a checker can
+// tell a long wait from a slot that was reused in between
+struct WaitSlot {
+    std::atomic<TaskHandle_t> task{nullptr};
+    std::atomic<SemaphoreHandle_t> handle{nullptr};
+    std::atomic<uint32_t> gen{0};
+    std::atomic<UBaseType_t> priority{0};  // Waiter's own priority, see ownPriority()
+};
+
+struct WaitSnapshot {
+    TaskHandle_t task;
+    SemaphoreHandle_t handle;
+    uint32_t gen;
+    UBaseType_t priority;
+};
+
+// Priority of the calling task without priority inheritance. In a cycle
+// every holder inherits from its waiter, so uxTaskPriorityGet() would make
+// all members look alike. Without the trace facility the current priority
+// is the best available, taken before the task blocks
+UBaseType_t ownPriority(TaskHandle_t self) {
+#if configUSE_TRACE_FACILITY && configUSE_MUTEXES
+    TaskStatus_t status;
+    vTaskGetInfo(self, &status, pdFALSE, eRunning);
+    return status.uxBasePriority;
+#else
+    return uxTaskPriorityGet(self);
+#endif
+}
+
+}  // namespace
+
+static WaitSlot s_waits[SEMAPHORE_GUARD_WAIT_SLOTS];
+static std::atomic<uint32_t> s_untracked{0};
+static std::atomic<uint32_t> s_found{0};
+static std::atomic<uint32_t> s_aborted{0};
+static std::atomic<DeadlockCallback> s_callback{nullptr};
+
+// Checker state, only touched by the task running check()
+static uint32_t s_suspectGen[SEMAPHORE_GUARD_WAIT_SLOTS];   // Seen in a cycle by the last check
+static uint32_t s_reportedGen[SEMAPHORE_GUARD_WAIT_SLOTS];  // Already reported
+
+static TaskHandle_t s_monitor = nullptr;
+static uint32_t s_periodMs = 1000;
+static bool s_abortVictim = false;
+
+bool DeadlockDetector::begin(uint32_t periodMs, bool abortVictim, UBaseType_t priority,
+                             BaseType_t core, uint32_t stackSize) {
+    if (s_monitor != nullptr) {
+        return true;
+    }
+    s_periodMs = periodMs > 0 ? periodMs : 1;
+    s_abortVictim = abortVictim;
+    if (xTaskCreatePinnedToCore(taskEntry, "deadlock", stackSize, nullptr,
+                                priority, &s_monitor, core) != pdPASS) {
+        DLD_LOG_E("Failed to create monitor task");
+        s_monitor = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void DeadlockDetector::taskEntry(void*) {
+    TickType_t lastWake = xTaskGetTickCount();
+    while (true) {
+        vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(s_periodMs));
+        check(s_abortVictim);
+    }
+}
+
+void DeadlockDetector::setCallback(DeadlockCallback callback) {
+    s_callback.store(callback, std::memory_order_release);
+}
+
+bool DeadlockDetector::take(SemaphoreHandle_t handle, TickType_t timeout, bool recursive) {
+    // Only takes that actually block are registered
+    const bool taken = recursive ? xSemaphoreTakeRecursive(handle, 0) == pdTRUE
+                                 : xSemaphoreTake(handle, 0) == pdTRUE;
+    if (taken || timeout == 0) {
+        return taken;
+    }
+
+    const int slot = beginWait(handle);
+    SemaphoreWaiters::enter(handle);
+    const bool result = recursive ? xSemaphoreTakeRecursive(handle, timeout) == pdTRUE
+                                  : xSemaphoreTake(handle, timeout) == pdTRUE;
+    SemaphoreWaiters::leave(handle);
+    endWait(slot);
+    return result;
+}
+
+int DeadlockDetector::beginWait(SemaphoreHandle_t handle) {
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    for (int i = 0; i < SEMAPHORE_GUARD_WAIT_SLOTS; i++) {
+        TaskHandle_t expected = nullptr;
+        if (s_waits[i].task.compare_exchange_strong(expected, self, std::memory_order_acq_rel)) {
+            s_waits[i].gen.fetch_add(1, std::memory_order_relaxed);
+            s_waits[i].priority.store(ownPriority(self), std::memory_order_relaxed);
+            s_waits[i].handle.store(handle, std::memory_order_release);
+            return i;
+        }
+    }
+    s_untracked.fetch_add(1, std::memory_order_relaxed);
+    return -1;
+}
+
+void DeadlockDetector::endWait(int slot) {
+    if (slot < 0) {
+        return;
+    }
+    s_waits[slot].handle.store(nullptr, std::memory_order_relaxed);
+    s_waits[slot].task.store(nullptr, std::memory_order_release);
+}
+
+static int findWaiter(const WaitSnapshot* waits, TaskHandle_t task) {
+    for (int i = 0; i < SEMAPHORE_GUARD_WAIT_SLOTS; i++) {
+        if (waits[i].task == task) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static void reportCycle(const DeadlockCycle& cycle) {
+    DLD_LOG_E("Deadlock between %u tasks:", (unsigned)cycle.length);
+    for (size_t i = 0; i < cycle.length; i++) {
+        const TaskHandle_t holder = cycle.tasks[(i + 1) % cycle.length];
+        DLD_LOG_E("  '%s' waits for %p held by '%s'",
+                  pcTaskGetName(cycle.tasks[i]), cycle.handles[i], pcTaskGetName(holder));
+    }
+}
+
+size_t DeadlockDetector::check(bool abortVictim) {
+    // Consistent copy of each registration: gen read before and after
+    WaitSnapshot waits[SEMAPHORE_GUARD_WAIT_SLOTS];
+    for (int i = 0; i < SEMAPHORE_GUARD_WAIT_SLOTS; i++) {
+        const uint32_t gen = s_waits[i].gen.load(std::memory_order_acquire);
+        waits[i].task = s_waits[i].task.load(std::memory_order_acquire);
+        waits[i].handle = s_waits[i].handle.load(std::memory_order_acquire);
+        waits[i].priority = s_waits[i].priority.load(std::memory_order_relaxed);
+        waits[i].gen = gen;
+        if (waits[i].task == nullptr || waits[i].handle == nullptr ||
+            s_waits[i].gen.load(std::memory_order_acquire) != gen) {
+            waits[i].task = nullptr;
+            waits[i].handle = nullptr;
+        }
+    }
+
+    size_t found = 0;
+    int path[SEMAPHORE_GUARD_WAIT_SLOTS];
+    for (int start = 0; start < SEMAPHORE_GUARD_WAIT_SLOTS; start++) {
+        if (waits[start].task == nullptr) {
+            continue;
+        }
+
+        // Follow waiter -> holder -> what the holder waits for. Each cycle is
+        // handled from its lowest slot only
+        size_t length = 0;
+        bool cycle = false;
+        int current = start;
+        while (length < SEMAPHORE_GUARD_WAIT_SLOTS) {
+            path[length++] = current;
+            const TaskHandle_t holder = xSemaphoreGetMutexHolder(waits[current].handle);
+            const int next = holder != nullptr ? findWaiter(waits, holder) : -1;
+            if (next == start) {
+                cycle = true;
+                break;
+            }
+            if (next < start) {
+                break;  // Chain ends, or reaches a cycle handled from a lower slot
+            }
+            current = next;
+        }
+        if (!cycle) {
+            continue;
+        }
+
+        // Confirm over two checks, report once
+        bool confirmed = true;
+        bool reported = true;
+        for (size_t i = 0; i < length; i++) {
+            const int slot = path[i];
+            confirmed = confirmed && s_suspectGen[slot] == waits[slot].gen;
+            reported = reported && s_reportedGen[slot] == waits[slot].gen;
+            s_suspectGen[slot] = waits[slot].gen;
+        }
+        if (!confirmed || reported) {
+            continue;
+        }
+
+        DeadlockCycle info;
+        info.length = length;
+        info.victim = nullptr;
+        int victimSlot = -1;
+        UBaseType_t lowest = configMAX_PRIORITIES;
+        for (size_t i = 0; i < length; i++) {
+            const int slot = path[i];
+            s_reportedGen[slot] = waits[slot].gen;
+            info.tasks[i] = waits[slot].task;
+            info.handles[i] = waits[slot].handle;
+            if (waits[slot].priority < lowest) {
+                lowest = waits[slot].priority;
+                info.victim = info.tasks[i];
+                victimSlot = slot;
+            }
+        }
+
+        reportCycle(info);
+        found++;
+        s_found.fetch_add(1, std::memory_order_relaxed);
+
+        if (abortVictim) {
+#if INCLUDE_xTaskAbortDelay
+            // The victim may have stopped waiting since the snapshot; then
+            // an abort would hit some unrelated delay of that task
+            const bool stillWaiting =
+                s_waits[victimSlot].gen.load(std::memory_order_acquire) == waits[victimSlot].gen &&
+                s_waits[victimSlot].task.load(std::memory_order_acquire) == info.victim;
+            if (stillWaiting && xTaskAbortDelay(info.victim) == pdPASS) {
+                s_aborted.fetch_add(1, std::memory_order_relaxed);
+                DLD_LOG_W("Aborted the wait of '%s' to break the deadlock", pcTaskGetName(info.victim));
+            } else {
+                info.victim = nullptr;
+            }
+#else
+            DLD_LOG_W("Cannot break deadlock: INCLUDE_xTaskAbortDelay is 0");
+            info.victim = nullptr;
+#endif
+        } else {
+            info.victim = nullptr;
+        }
+
+        const DeadlockCallback callback = s_callback.load(std::memory_order_acquire);
+        if (callback != nullptr) {
+            callback(info);
+        }
+    }
+    return found;
+}
+
+uint32_t DeadlockDetector::deadlocksFound() {
+    return s_found.load(std::memory_order_relaxed);
+}
+
+uint32_t DeadlockDetector::victimsAborted() {
+    return s_aborted.load(std::memory_order_relaxed);
+}
+
+uint32_t DeadlockDetector::untracked() {
+    return s_untracked.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,107 @@
+#ifndef _DEADLOCK_DETECTOR_H_
+#define _DEADLOCK_DETECTOR_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+
+// Blocked takes that can be tracked at the same time; further ones are
+// counted as untracked and invisible to the detector
+#ifndef SEMAPHORE_GUARD_WAIT_SLOTS
+#define SEMAPHORE_GUARD_WAIT_SLOTS 16
+#endif
+
+// A confirmed cycle: tasks[i] waits for handles[i], which tasks[i + 1]
+// holds; the last task waits for a handle the first one holds
+struct DeadlockCycle {
+    size_t length;
+    TaskHandle_t tasks[SEMAPHORE_GUARD_WAIT_SLOTS];
+    SemaphoreHandle_t handles[SEMAPHORE_GUARD_WAIT_SLOTS];
+    TaskHandle_t victim;  // Task whose wait was aborted, or nullptr
+};
+
+// Invoked on the checking task for every confirmed deadlock
+typedef void (*DeadlockCallback)(const DeadlockCycle& cycle);
+
+// Live wait-for graph and deadlock detection.
+//
+// A take that cannot succeed immediately registers "task waits for handle"
+// in a fixed table for as long as it blocks; uncontended takes register
+// nothing. check() follows each waiter to the holder of the handle it
+// waits for (xSemaphoreGetMutexHolder()), to what that holder waits for,
+// and so on. A chain that returns to its start is a deadlock. A cycle is
+// only reported once the same registrations have been part of it in two
+// consecutive checks, so waits that are just resolving are not flagged.
+//
+// Reporting logs the cycle and calls the callback. With abortVictim the
+// task with the lowest own priority in the cycle is woken with
+// xTaskAbortDelay(). Inherited priorities are ignored when
+// configUSE_TRACE_FACILITY is on; otherwise each task's priority when it
+// started to wait is used, which may already include inheritance. Its
+// take fails as if it had timed out (hasLock() == false), even with
+// portMAX_DELAY. Code that holds guards with infinite timeouts must check
+// hasLock() for this to be safe.
+//
+// Takes are tracked by DeadlockAwareAcquire, or by every default guard when
+// built with -DSEMAPHORE_GUARD_DEADLOCK_DETECTION. Only mutexes and
+// recursive mutexes have a holder, so cycles through binary or counting
+// semaphores are not seen.
+//
+//     DeadlockDetector::begin(1000, true);   // Check every second, break cycles
+class DeadlockDetector {
+public:
+    // Start a monitor task that runs check() every periodMs
+    static bool begin(uint32_t periodMs = 1000, bool abortVictim = false,
+                      UBaseType_t priority = 1, BaseType_t core = tskNO_AFFINITY,
+                      uint32_t stackSize = 3072);
+
+    // Scan the wait-for graph once; returns the number of newly confirmed
+    // deadlocks. Call from one task at a time: the monitor task, or your own
+    // supervisor instead of begin()
+    static size_t check(bool abortVictim = false);
+
+    // Called for every confirmed deadlock, in addition to the log
+    static void setCallback(DeadlockCallback callback);
+
+    // Take, registering the wait while it blocks
+    static bool take(SemaphoreHandle_t handle, TickType_t timeout, bool recursive);
+
+    // Deadlocks confirmed so far
+    [[nodiscard]] static uint32_t deadlocksFound();
+
+    // Waits aborted to break a deadlock
+    [[nodiscard]] static uint32_t victimsAborted();
+
+    // Blocking takes not tracked because the wait table was full
+    [[nodiscard]] static uint32_t untracked();
+
+private:
+    static int beginWait(SemaphoreHandle_t handle);
+    static void endWait(int slot);
+    static void taskEntry(void* param);
+};
+
+// Acquire policies for BasicSemaphoreGuard that make the guard's waits
+// visible to DeadlockDetector
+struct DeadlockAwareAcquire {
+    static bool take(SemaphoreHandle_t handle, TickType_t timeout) {
+        return DeadlockDetector::take(handle, timeout, false);
+    }
+    static void give(SemaphoreHandle_t handle) {
+        xSemaphoreGive(handle);
+    }
+};
+
+struct DeadlockAwareRecursiveAcquire {
+    static constexpr bool recursive = true;
+    static bool take(SemaphoreHandle_t handle, TickType_t timeout) {
+        return DeadlockDetector::take(handle, timeout, true);
+    }
+    static void give(SemaphoreHandle_t handle) {
+        xSemaphoreGiveRecursive(handle);
+    }
+};
+
+#endif  // _DEADLOCK_DETECTOR_H_
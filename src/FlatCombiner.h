@@ -0,0 +1,229 @@
+#ifndef _FLAT_COMBINER_H_
+#define _FLAT_COMBINER_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <atomic>
+
+#include "SemaphoreGuard.h"
+
+// Flat-combining executor for short operations on a heavily contended lock.
+//
+// Instead of every task blocking in xSemaphoreTake(), a task publishes its
+// operation in a per-task slot and tries the lock without waiting. Whoever
+// wins (via SemaphoreGuard) becomes the combiner and runs every pending
+// operation in one pass, then signals each owner with a task notification.
+// Losers sleep on their notification and usually wake with the work done.
+//
+// Operations run on the combiner's task, so they must not depend on the
+// identity of the calling task and must not block. The slot owner is woken
+// with xTaskNotifyGive() and execute() consumes that notification before
+// it returns. A pending notification from elsewhere can still be swallowed
+// by the wait, so tasks that use the default notification for other
+// purposes should not call execute().
+template <size_t MaxTasks = 8>
+class FlatCombiner {
+public:
+    typedef void (*Operation)(void* arg);
+
+    FlatCombiner() : m_passes{0}, m_combined{0} {
+        for (size_t i = 0; i < MaxTasks; i++) {
+            m_slots[i].owner.store(nullptr, std::memory_order_relaxed);
+            m_slots[i].state.store(kIdle, std::memory_order_relaxed);
+            m_slots[i].op = nullptr;
+            m_slots[i].arg = nullptr;
+        }
+        m_mutex = xSemaphoreCreateMutexStatic(&m_mutexBuffer);
+    }
+
+    ~FlatCombiner() {
+        if (m_mutex != nullptr) {
+            vSemaphoreDelete(m_mutex);
+        }
+    }
+
+    // Delete copy and move; slots are referenced by their owning tasks
+    FlatCombiner(const FlatCombiner&) = delete;
+    FlatCombiner& operator=(const FlatCombiner&) = delete;
+    FlatCombiner(FlatCombiner&&) = delete;
+    FlatCombiner& operator=(FlatCombiner&&) = delete;
+
+    // Run op(arg) under the lock, either here or on the current combiner.
+    // Returns false if the operation could not be run within the timeout;
+    // in that case it is guaranteed not to run later
+    bool execute(Operation op, void* arg, TickType_t timeout = portMAX_DELAY) {
+        if (op == nullptr) {
+            return false;
+        }
+
+        Slot* slot = claimSlot();
+        if (slot == nullptr) {
+            // More tasks than slots: fall back to plain locking
+            SemaphoreGuard guard(m_mutex, timeout);
+            if (guard.hasLock()) {
+                op(arg);
+            }
+            return guard.hasLock();
+        }
+
+        slot->op = op;
+        slot->arg = arg;
+        slot->state.store(kPending, std::memory_order_release);
+
+        const TickType_t start = xTaskGetTickCount();
+        bool notified = false;  // The combiner's notification was consumed
+        while (true) {
+            combineIfFree();
+
+            if (isDone(slot->state.load(std::memory_order_acquire))) {
+                return finish(*slot, notified);
+            }
+
+            const TickType_t elapsed = xTaskGetTickCount() - start;
+            if (timeout != portMAX_DELAY && elapsed >= timeout) {
+                uint8_t expected = kPending;
+                if (slot->state.compare_exchange_strong(expected, kIdle, std::memory_order_acq_rel)) {
+                    return false;
+                }
+                // A combiner already picked it up; it completes shortly
+                while (!isDone(slot->state.load(std::memory_order_acquire))) {
+                    notified = ulTaskNotifyTake(pdTRUE, 1) != 0 || notified;
+                }
+                return finish(*slot, notified);
+            }
+
+            // Woken by the combiner when our operation is done; the timeout
+            // retries the lock in case the combiner left before publishing
+            notified = ulTaskNotifyTake(pdTRUE, 1) != 0 || notified;
+        }
+    }
+
+    // Give up the calling task's slot, e.g. before the task deletes itself
+    void detach() {
+        const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+        for (size_t i = 0; i < MaxTasks; i++) {
+            if (m_slots[i].owner.load(std::memory_order_relaxed) == self) {
+                m_slots[i].owner.store(nullptr, std::memory_order_release);
+                return;
+            }
+        }
+    }
+
+    // Combining passes run, and operations executed by those passes
+    [[nodiscard]] uint32_t passes() const noexcept { return m_passes.load(std::memory_order_relaxed); }
+    [[nodiscard]] uint32_t combinedOperations() const noexcept {
+        return m_combined.load(std::memory_order_relaxed);
+    }
+
+    // Underlying mutex, for code that must also run outside the combiner
+    [[nodiscard]] SemaphoreHandle_t getHandle() const noexcept { return m_mutex; }
+
+private:
+    // kDone: run by the owner itself; kNotified: run by another combiner,
+    // which gives the owner exactly one notification after the store
+    enum : uint8_t { kIdle = 0, kPending = 1, kRunning = 2, kDone = 3, kNotified = 4 };
+
+    // Passes per combining session; bounds the combiner's hold time
+    static constexpr int kMaxPasses = 3;
+
+    struct Slot {
+        std::atomic<TaskHandle_t> owner;
+        std::atomic<uint8_t> state;
+        Operation op;
+        void* arg;
+    };
+
+    Slot* claimSlot() {
+        const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+        for (size_t i = 0; i < MaxTasks; i++) {
+            if (m_slots[i].owner.load(std::memory_order_relaxed) == self) {
+                return &m_slots[i];
+            }
+        }
+        for (size_t i = 0; i < MaxTasks; i++) {
+            TaskHandle_t expected = nullptr;
+            if (m_slots[i].owner.compare_exchange_strong(expected, self, std::memory_order_acq_rel)) {
+                return &m_slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    // Runs with m_mutex held
+    void combine() {
+        for (int pass = 0; pass < kMaxPasses; pass++) {
+            bool found = false;
+            for (size_t i = 0; i < MaxTasks; i++) {
+                Slot& slot = m_slots[i];
+                uint8_t expected = kPending;
+                if (!slot.state.compare_exchange_strong(expected, kRunning, std::memory_order_acq_rel)) {
+                    continue;
+                }
+                found = true;
+                slot.op(slot.arg);
+                m_combined.fetch_add(1, std::memory_order_relaxed);
+
+                const TaskHandle_t owner = slot.owner.load(std::memory_order_relaxed);
+                if (owner == xTaskGetCurrentTaskHandle()) {
+                    slot.state.store(kDone, std::memory_order_release);
+                } else {
+                    slot.state.store(kNotified, std::memory_order_release);
+                    xTaskNotifyGive(owner);
+                }
+            }
+            m_passes.fetch_add(1, std::memory_order_relaxed);
+            if (!found) {
+                break;
+            }
+        }
+    }
+
+    static bool isDone(uint8_t state) {
+        return state == kDone || state == kNotified;
+    }
+
+    // Combine if the lock is free. Work published after the last pass gets
+    // one more session here instead of a wake-up of its owner, so the only
+    // notification a slot owner ever receives is its completion
+    void combineIfFree() {
+        for (int session = 0; session < 2; session++) {
+            {
+                SemaphoreGuard guard(m_mutex, 0);
+                if (!guard.hasLock()) {
+                    return;
+                }
+                combine();
+            }
+            if (!anyPending()) {
+                return;
+            }
+        }
+    }
+
+    bool anyPending() const {
+        for (size_t i = 0; i < MaxTasks; i++) {
+            if (m_slots[i].state.load(std::memory_order_acquire) == kPending) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Consume the combiner's notification if it is still outstanding, so it
+    // cannot wake a later, unrelated notification wait of this task
+    bool finish(Slot& slot, bool notified) {
+        if (slot.state.load(std::memory_order_acquire) == kNotified && !notified) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        }
+        slot.state.store(kIdle, std::memory_order_relaxed);
+        return true;
+    }
+
+    Slot m_slots[MaxTasks];
+    StaticSemaphore_t m_mutexBuffer;
+    SemaphoreHandle_t m_mutex;
+    std::atomic<uint32_t> m_passes;    // Updated under m_mutex, read anywhere
+    std::atomic<uint32_t> m_combined;  // Updated under m_mutex, read anywhere
+};
+
+#endif  // _FLAT_COMBINER_H_
@@ -0,0 +1,12 @@
+#ifndef _GUARD_SITE_H_
+#define _GUARD_SITE_H_
+
+// Where an acquisition came from: the return address of the guard
+// constructor (or lock()), plus file and line in debug builds
+struct GuardSite {
+    const char* file;
+    int line;
+    const void* caller;
+};
+
+#endif  // _GUARD_SITE_H_
@@ -0,0 +1,108 @@
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+#include "HeldList.h"
+#include "CriticalSectionGuard.h"
+
+// Guards every link change, so snapshot() can read another task's list
+// while that task keeps running. Held only for a few pointer writes
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static HeldListNode* head(TaskHandle_t task) {
+    return static_cast<HeldListNode*>(pvTaskGetThreadLocalStoragePointer(task, SEMAPHORE_GUARD_HELD_LIST_TLS_INDEX));
+}
+
+static void setHead(HeldListNode* node) {
+    vTaskSetThreadLocalStoragePointer(nullptr, SEMAPHORE_GUARD_HELD_LIST_TLS_INDEX, node);
+}
+
+void HeldList::push(HeldListNode& node, SemaphoreHandle_t handle, const GuardSite& site) {
+    node.handle = handle;
+    node.site = site;
+    CriticalSectionGuard guard(&s_mux);
+    node.next = head(nullptr);
+    setHead(&node);
+}
+
+void HeldList::remove(HeldListNode& node) {
+    CriticalSectionGuard guard(&s_mux);
+    // Guards normally release in reverse order, so this is the head
+    HeldListNode* current = head(nullptr);
+    if (current == &node) {
+        setHead(node.next);
+    } else {
+        while (current != nullptr && current->next != &node) {
+            current = current->next;
+        }
+        if (current == nullptr) {
+            return;  // Not linked
+        }
+        current->next = node.next;
+    }
+    node.next = nullptr;
+    node.handle = nullptr;
+}
+
+bool HeldList::holds(SemaphoreHandle_t handle) {
+    for (const HeldListNode* node = head(nullptr); node != nullptr; node = node->next) {
+        if (node->handle == handle) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool HeldList::wouldSelfDeadlock(SemaphoreHandle_t handle, const GuardSite& site) {
+    const HeldListNode* node = head(nullptr);
+    while (node != nullptr && node->handle != handle) {
+        node = node->next;
+    }
+    if (node == nullptr) {
+        return false;
+    }
+
+    // Counting and binary semaphores may legitimately be taken again
+    if (xSemaphoreGetMutexHolder(handle) != xTaskGetCurrentTaskHandle()) {
+        return false;
+    }
+
+    if (node->site.file != nullptr && site.file != nullptr) {
+        HELD_LOG_E("Self-deadlock: '%s' takes mutex %p at %s:%d, already held since %s:%d",
+                   pcTaskGetName(nullptr), handle, site.file, site.line, node->site.file, node->site.line);
+    } else {
+        HELD_LOG_E("Self-deadlock: '%s' takes mutex %p from %p, already held since %p",
+                   pcTaskGetName(nullptr), handle, site.caller, node->site.caller);
+    }
+    return true;
+}
+
+size_t HeldList::snapshot(TaskHandle_t task, HeldListEntry* out, size_t maxEntries) {
+    if (task == nullptr) {
+        task = xTaskGetCurrentTaskHandle();
+    }
+
+    // A guard unlinks itself under s_mux before its stack frame goes away,
+    // so every node reached here is alive for the whole copy
+    CriticalSectionGuard guard(&s_mux);
+    size_t count = 0;
+    for (const HeldListNode* node = head(task); node != nullptr && count < maxEntries; node = node->next) {
+        out[count].handle = node->handle;
+        out[count].site = node->site;
+        count++;
+    }
+    return count;
+}
+
+void HeldList::print(TaskHandle_t task) {
+    HeldListEntry entries[16];
+    const size_t count = snapshot(task, entries, sizeof(entries) / sizeof(entries[0]));
+    const char* name = pcTaskGetName(task);
+    HELD_LOG_I("'%s' holds %u lock(s)", name, (unsigned)count);
+    for (size_t i = 0; i < count; i++) {
+        if (entries[i].site.file != nullptr) {
+            HELD_LOG_I("  %p taken at %s:%d", entries[i].handle, entries[i].site.file, entries[i].site.line);
+        } else {
+            HELD_LOG_I("  %p taken from %p", entries[i].handle, entries[i].site.caller);
+        }
+    }
+}
+
+#endif  // SEMAPHORE_GUARD_HELD_LIST
@@ -0,0 +1,80 @@
+#ifndef _HELD_LIST_H_
+#define _HELD_LIST_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "GuardSite.h"
+
+// Thread-local storage slot holding the head of each task's list. The
+// last slot belongs to lock ranks (LockRank.h) and slot 0 to pthreads, so
+// this one defaults to the slot before the last and needs
+// CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS=3 or more. Only include
+// this header in builds with -DSEMAPHORE_GUARD_HELD_LIST
+#ifndef SEMAPHORE_GUARD_HELD_LIST_TLS_INDEX
+#define SEMAPHORE_GUARD_HELD_LIST_TLS_INDEX (configNUM_THREAD_LOCAL_STORAGE_POINTERS - 2)
+#endif
+
+static_assert(SEMAPHORE_GUARD_HELD_LIST_TLS_INDEX >= 1 &&
+              SEMAPHORE_GUARD_HELD_LIST_TLS_INDEX < configNUM_THREAD_LOCAL_STORAGE_POINTERS,
+              "SEMAPHORE_GUARD_HELD_LIST_TLS_INDEX must be a thread-local storage slot other than "
+              "pthread's slot 0; raise CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS");
+
+// Link embedded in each guard; the guard is the list element
+struct HeldListNode {
+    HeldListNode* next = nullptr;
+    SemaphoreHandle_t handle = nullptr;
+    GuardSite site = {nullptr, 0, nullptr};
+};
+
+// Copy of one entry, for diagnostics
+struct HeldListEntry {
+    SemaphoreHandle_t handle;
+    GuardSite site;
+};
+
+// Per-task list of the guards a task currently holds.
+//
+// With -DSEMAPHORE_GUARD_HELD_LIST every BasicSemaphoreGuard carries a
+// HeldListNode and links itself, newest first, into a list rooted in a
+// thread-local storage slot of the owning task. Nothing is allocated and
+// no global table is involved: only the owner ever modifies its list. Links
+// change inside a short critical section, so other tasks can read a list
+// consistently without stopping its owner.
+//
+// Before each take the guard looks through its own task's list. If the
+// handle is already there, is a mutex (xSemaphoreGetMutexHolder() reports
+// this task) and the guard does not take recursively, the take could
+// never succeed. The guard logs the self-deadlock and fails with
+// hasLock() == false instead of blocking forever. That covers a plain
+// mutex taken twice and a recursive mutex taken through SemaphoreGuard.
+//
+//     HeldList::print(nullptr);        // What does this task hold?
+//     HeldList::print(xModbusTask);    // ... or another task
+class HeldList {
+public:
+    // Link a guard that has just taken handle
+    static void push(HeldListNode& node, SemaphoreHandle_t handle, const GuardSite& site);
+
+    // Unlink a guard before it gives its handle back
+    static void remove(HeldListNode& node);
+
+    // Check if the calling task holds handle through a guard
+    [[nodiscard]] static bool holds(SemaphoreHandle_t handle);
+
+    // Check if taking handle non-recursively would wait for this task itself;
+    // logs the self-deadlock when it would
+    [[nodiscard]] static bool wouldSelfDeadlock(SemaphoreHandle_t handle, const GuardSite& site);
+
+    // Copy up to maxEntries held locks of task (nullptr: calling task),
+    // newest first. The copy is made inside the critical section that
+    // guards the links, so the task cannot unlink a guard meanwhile
+    static size_t snapshot(TaskHandle_t task, HeldListEntry* out, size_t maxEntries);
+
+    // Log the locks task holds (nullptr: calling task)
+    static void print(TaskHandle_t task);
+};
+
+#endif  // _HELD_LIST_H_
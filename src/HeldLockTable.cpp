@@ -0,0 +1,201 @@
+#include "HeldLockTable.h"
+#include <string.h>
+#ifdef ESP_PLATFORM
+#include <esp_attr.h>
+#include <esp_idf_version.h>
+#include <esp_system.h>
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+#include <esp_app_desc.h>
+#else
+#include <esp_ota_ops.h>
+#endif
+#endif
+
+// Where the table is kept. Must not be cleared at startup and must
+// support atomic instructions (internal RAM)
+#ifndef SEMAPHORE_GUARD_HELD_LOCK_ATTR
+#ifdef ESP_PLATFORM
+#define SEMAPHORE_GUARD_HELD_LOCK_ATTR __NOINIT_ATTR
+#else
+#define SEMAPHORE_GUARD_HELD_LOCK_ATTR
+#endif
+#endif
+
+namespace {
+
+constexpr uint32_t kMagic = 0x484C4B54;  // "HLKT"
+
+// Plain data only: a noinit section runs no constructors, so slots are
+// claimed with the GCC atomic builtins instead of std::atomic
+struct RetainedTable {
+    uint32_t magic;
+    uint32_t stamp;
+    uint32_t dropped;
+    TickType_t lastTick;  // Latest acquisition; bounds how long entries were held
+    HeldLockRecord records[SEMAPHORE_GUARD_HELD_LOCK_SLOTS];
+};
+
+constexpr uint32_t fnv1a(const char* text, uint32_t hash = 2166136261u) {
+    return *text == '\0' ? hash : fnv1a(text + 1, (hash ^ static_cast<uint8_t>(*text)) * 16777619u);
+}
+
+// Identifies the firmware that wrote the table, so stale file-name pointers
+// from another build are never dereferenced. On ESP32 it is taken from the
+// app's ELF SHA-256, which changes with any code change; host builds fall
+// back to this file's build time
+uint32_t firmwareStamp() {
+    uint32_t stamp = static_cast<uint32_t>(sizeof(RetainedTable)) << 16;
+#ifdef ESP_PLATFORM
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    const esp_app_desc_t* app = esp_app_get_description();
+#else
+    const esp_app_desc_t* app = esp_ota_get_app_description();
+#endif
+    uint32_t sha;
+    memcpy(&sha, app->app_elf_sha256, sizeof(sha));
+    stamp ^= sha;
+#else
+    stamp ^= fnv1a(__DATE__ " " __TIME__);
+#endif
+    return stamp;
+}
+
+}  // namespace
+
+static SEMAPHORE_GUARD_HELD_LOCK_ATTR RetainedTable s_table;
+
+// Ordinary RAM: cleared on every boot
+static bool s_recording = false;
+static HeldLockRecord s_previous[SEMAPHORE_GUARD_HELD_LOCK_SLOTS];
+static size_t s_previousCount = 0;
+static uint32_t s_previousDropped = 0;
+static TickType_t s_previousLastTick = 0;
+
+void HeldLockTable::begin() {
+    __atomic_store_n(&s_recording, false, __ATOMIC_RELEASE);
+    const uint32_t stamp = firmwareStamp();
+
+    s_previousCount = 0;
+    s_previousDropped = 0;
+    s_previousLastTick = 0;
+    if (s_table.magic == kMagic && s_table.stamp == stamp) {
+        for (size_t i = 0; i < SEMAPHORE_GUARD_HELD_LOCK_SLOTS; i++) {
+            if (s_table.records[i].handle != nullptr) {
+                s_previous[s_previousCount++] = s_table.records[i];
+            }
+        }
+        s_previousDropped = s_table.dropped;
+        s_previousLastTick = s_table.lastTick;
+    }
+
+    memset(&s_table, 0, sizeof(s_table));
+    s_table.magic = kMagic;
+    s_table.stamp = stamp;
+    __atomic_store_n(&s_recording, true, __ATOMIC_RELEASE);
+}
+
+int HeldLockTable::record(SemaphoreHandle_t handle, const GuardSite& site) {
+    if (!__atomic_load_n(&s_recording, __ATOMIC_RELAXED)) {
+        return -1;
+    }
+
+    for (int i = 0; i < SEMAPHORE_GUARD_HELD_LOCK_SLOTS; i++) {
+        HeldLockRecord& entry = s_table.records[i];
+        SemaphoreHandle_t expected = nullptr;
+        if (__atomic_compare_exchange_n(&entry.handle, &expected, handle, false,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            const TickType_t now = xTaskGetTickCount();
+            entry.task = xTaskGetCurrentTaskHandle();
+            entry.file = site.file;
+            entry.line = site.line;
+            entry.caller = site.caller;
+            entry.acquiredTick = now;
+            strncpy(entry.taskName, pcTaskGetName(nullptr), sizeof(entry.taskName) - 1);
+            entry.taskName[sizeof(entry.taskName) - 1] = '\0';
+            s_table.lastTick = now;
+            return i;
+        }
+    }
+
+    __atomic_fetch_add(&s_table.dropped, 1, __ATOMIC_RELAXED);
+    return -1;
+}
+
+void HeldLockTable::erase(int slot) {
+    if (slot < 0 || slot >= SEMAPHORE_GUARD_HELD_LOCK_SLOTS) {
+        return;
+    }
+    HeldLockRecord& entry = s_table.records[slot];
+    entry.file = nullptr;
+    entry.caller = nullptr;
+    entry.taskName[0] = '\0';
+    __atomic_store_n(&entry.handle, nullptr, __ATOMIC_RELEASE);
+}
+
+static void printRecord(const HeldLockRecord& entry, TickType_t lastTick, bool sameBoot) {
+    const unsigned long held = (unsigned long)(lastTick - entry.acquiredTick);
+    if (entry.file != nullptr) {
+        HLT_LOG_W("  %p held by '%s' for >= %lu ticks, taken at %s:%d",
+                  entry.handle, entry.taskName, held, entry.file, entry.line);
+    } else {
+        HLT_LOG_W("  %p held by '%s' for >= %lu ticks, taken from %p",
+                  entry.handle, entry.taskName, held, entry.caller);
+    }
+    if (sameBoot) {
+        HLT_LOG_D("    owner task %p", entry.task);
+    }
+}
+
+void HeldLockTable::printPrevious() {
+#ifdef ESP_PLATFORM
+    const int reason = static_cast<int>(esp_reset_reason());
+#else
+    const int reason = 0;  // Host builds: no reset reason
+#endif
+    if (s_previousCount == 0) {
+        HLT_LOG_I("No locks were held at the last reset (reason %d)", reason);
+        return;
+    }
+
+    HLT_LOG_W("%u lock(s) held at the last reset (reason %d):", (unsigned)s_previousCount, reason);
+    for (size_t i = 0; i < s_previousCount; i++) {
+        printRecord(s_previous[i], s_previousLastTick, false);
+    }
+    if (s_previousDropped > 0) {
+        HLT_LOG_W("  %lu acquisition(s) did not fit in the table", (unsigned long)s_previousDropped);
+    }
+}
+
+void HeldLockTable::printCurrent() {
+    const TickType_t now = xTaskGetTickCount();
+    HLT_LOG_I("%u lock(s) held now:", (unsigned)heldCount());
+    for (size_t i = 0; i < SEMAPHORE_GUARD_HELD_LOCK_SLOTS; i++) {
+        // Copy first: the owner may release the slot meanwhile
+        HeldLockRecord entry = s_table.records[i];
+        if (entry.handle != nullptr) {
+            printRecord(entry, now, true);
+        }
+    }
+}
+
+size_t HeldLockTable::previousCount() {
+    return s_previousCount;
+}
+
+const HeldLockRecord& HeldLockTable::previous(size_t index) {
+    return s_previous[index < s_previousCount ? index : 0];
+}
+
+size_t HeldLockTable::heldCount() {
+    size_t count = 0;
+    for (size_t i = 0; i < SEMAPHORE_GUARD_HELD_LOCK_SLOTS; i++) {
+        if (__atomic_load_n(&s_table.records[i].handle, __ATOMIC_ACQUIRE) != nullptr) {
+            count++;
+        }
+    }
+    return count;
+}
+
+uint32_t HeldLockTable::dropped() {
+    return __atomic_load_n(&s_table.dropped, __ATOMIC_RELAXED);
+}
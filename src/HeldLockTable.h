@@ -0,0 +1,107 @@
+#ifndef _HELD_LOCK_TABLE_H_
+#define _HELD_LOCK_TABLE_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "GuardSite.h"
+
+// Locks that can be recorded at the same time; further ones are counted
+// as dropped
+#ifndef SEMAPHORE_GUARD_HELD_LOCK_SLOTS
+#define SEMAPHORE_GUARD_HELD_LOCK_SLOTS 16
+#endif
+
+// Characters of the owner's task name kept per entry, including the terminator
+#ifndef SEMAPHORE_GUARD_HELD_LOCK_NAME_LEN
+#define SEMAPHORE_GUARD_HELD_LOCK_NAME_LEN 12
+#endif
+
+// One held lock. Task handles and addresses refer to the boot that
+// recorded them; after a reset only the name, file/line and caller are
+// meaningful
+struct HeldLockRecord {
+    SemaphoreHandle_t handle;   // nullptr: slot free
+    TaskHandle_t task;
+    const char* file;           // Debug builds; nullptr otherwise
+    int line;
+    const void* caller;         // Return address of the guard constructor
+    TickType_t acquiredTick;
+    char taskName[SEMAPHORE_GUARD_HELD_LOCK_NAME_LEN];
+};
+
+// Fixed-size table of currently held guards that survives a reset.
+//
+// The table lives in a section the startup code does not clear (internal
+// RAM .noinit on ESP32, which keeps its contents over watchdog, panic and
+// software resets but not power loss). Guards claim a slot with one
+// compare-and-swap and free it on release; nothing else is locked.
+//
+// Enable recording in every default guard with
+// -DSEMAPHORE_GUARD_HELD_LOCK_TABLE, or use HeldLockRecorder as the stats
+// policy of chosen guards only. Then, early in setup():
+//
+//     HeldLockTable::begin();          // Keep last boot's table, start a new one
+//     HeldLockTable::printPrevious();  // Locks held when the unit reset
+//
+// A call site is printed as file:line in debug builds, otherwise as a code
+// address for `xtensa-esp32-elf-addr2line -e firmware.elf <address>`. The
+// address is exact with -DSEMAPHORE_GUARD_HELD_LOCK_TABLE, which keeps the
+// guard constructors out of line. With HeldLockRecorder alone they may be
+// inlined, and the address then points into the caller of the function
+// holding the guard. A table written by a different build (another app
+// ELF SHA-256) is discarded, since its file-name pointers would be
+// meaningless.
+//
+// Host builds without ESP_PLATFORM use an ordinary static buffer; calling
+// begin() again stands in for a reboot.
+class HeldLockTable {
+public:
+    // Snapshot the table left by the previous boot if it is valid, then
+    // clear it and start recording. Call before any recorded guard is held
+    static void begin();
+
+    // Claim a slot for a held lock; returns the slot or -1 when not recording or full
+    static int record(SemaphoreHandle_t handle, const GuardSite& site);
+
+    // Free a slot returned by record(); -1 is ignored
+    static void erase(int slot);
+
+    // Log the locks held when the previous boot ended
+    static void printPrevious();
+
+    // Log the locks held right now
+    static void printCurrent();
+
+    // Locks recorded as held when the previous boot ended
+    [[nodiscard]] static size_t previousCount();
+    [[nodiscard]] static const HeldLockRecord& previous(size_t index);
+
+    // Locks recorded as held right now
+    [[nodiscard]] static size_t heldCount();
+
+    // Acquisitions not recorded this boot because the table was full
+    [[nodiscard]] static uint32_t dropped();
+};
+
+// Stats policy that records the guard in HeldLockTable while it holds the lock
+struct HeldLockRecorder {
+    void onAcquireStart(SemaphoreHandle_t) {}
+    void onAcquireEnd(SemaphoreHandle_t handle, bool taken, const GuardSite& site) {
+        if (taken) {
+            m_slot = static_cast<int8_t>(HeldLockTable::record(handle, site));
+        }
+    }
+    void onRelease(SemaphoreHandle_t) {
+        HeldLockTable::erase(m_slot);
+        m_slot = -1;
+    }
+
+    int8_t m_slot = -1;
+};
+
+static_assert(SEMAPHORE_GUARD_HELD_LOCK_SLOTS <= 127, "HeldLockRecorder stores the slot in an int8_t");
+
+#endif  // _HELD_LOCK_TABLE_H_
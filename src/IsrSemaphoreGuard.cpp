@@ -0,0 +1,55 @@
+#include "IsrSemaphoreGuard.h"
+#include <esp_attr.h>
+
+// Everything here runs from interrupt handlers and must stay in IRAM so it
+// is callable while the flash cache is disabled. Logging is only possible
+// on the misuse path, which by definition runs in task context.
+
+IRAM_ATTR IsrYieldScope::~IsrYieldScope() {
+    if (m_woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+IRAM_ATTR IsrSemaphoreGuard::IsrSemaphoreGuard(SemaphoreHandle_t handle)
+    : m_handle(handle), m_taken(false), m_ownsYield(true),
+      m_ownWoken(pdFALSE), m_woken(&m_ownWoken) {
+    // Check for null handle
+    if (m_handle == nullptr) {
+        return;
+    }
+
+    // Check that we really are in ISR context
+    if (!xPortInIsrContext()) {
+        ISEMG_LOG_E("Cannot use IsrSemaphoreGuard outside ISR context");
+        return;
+    }
+
+    m_taken = (xSemaphoreTakeFromISR(m_handle, m_woken) == pdTRUE);
+}
+
+IRAM_ATTR IsrSemaphoreGuard::IsrSemaphoreGuard(SemaphoreHandle_t handle, IsrYieldScope& scope)
+    : m_handle(handle), m_taken(false), m_ownsYield(false),
+      m_ownWoken(pdFALSE), m_woken(scope.woken()) {
+    // Check for null handle
+    if (m_handle == nullptr) {
+        return;
+    }
+
+    // Check that we really are in ISR context
+    if (!xPortInIsrContext()) {
+        ISEMG_LOG_E("Cannot use IsrSemaphoreGuard outside ISR context");
+        return;
+    }
+
+    m_taken = (xSemaphoreTakeFromISR(m_handle, m_woken) == pdTRUE);
+}
+
+IRAM_ATTR IsrSemaphoreGuard::~IsrSemaphoreGuard() {
+    if (m_taken && m_handle != nullptr) {
+        xSemaphoreGiveFromISR(m_handle, m_woken);
+    }
+    if (m_ownsYield && m_ownWoken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
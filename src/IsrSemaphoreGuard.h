@@ -0,0 +1,75 @@
+#ifndef _ISR_SEMAPHORE_GUARD_H_
+#define _ISR_SEMAPHORE_GUARD_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+
+// Collects the pxHigherPriorityTaskWoken flag of every IsrSemaphoreGuard in
+// one interrupt handler and issues a single portYIELD_FROM_ISR() when it goes
+// out of scope. Declare it before the guards so it is destroyed after them.
+class IsrYieldScope {
+public:
+    IsrYieldScope() : m_woken(pdFALSE) {}
+
+    // Destructor: Yields once if any give/take woke a higher priority task
+    ~IsrYieldScope();
+
+    // Delete copy and move; guards hold a pointer to the flag
+    IsrYieldScope(const IsrYieldScope&) = delete;
+    IsrYieldScope& operator=(const IsrYieldScope&) = delete;
+    IsrYieldScope(IsrYieldScope&&) = delete;
+    IsrYieldScope& operator=(IsrYieldScope&&) = delete;
+
+    // Flag to pass to other ...FromISR() calls made in the same handler
+    BaseType_t* woken() noexcept { return &m_woken; }
+
+    // Check if a context switch will be requested on scope exit
+    [[nodiscard]] bool yieldRequested() const noexcept { return m_woken == pdTRUE; }
+
+private:
+    BaseType_t m_woken;
+};
+
+// SemaphoreGuard counterpart for interrupt handlers. Uses
+// xSemaphoreTakeFromISR() / xSemaphoreGiveFromISR(), which never block, so
+// there is no timeout. Only binary and counting semaphores may be used from
+// an ISR; FreeRTOS does not allow mutexes here.
+class IsrSemaphoreGuard {
+public:
+    // Constructor: Takes the semaphore and yields on its own destruction
+    explicit IsrSemaphoreGuard(SemaphoreHandle_t handle);
+
+    // Constructor: Takes the semaphore and defers the yield to the scope
+    IsrSemaphoreGuard(SemaphoreHandle_t handle, IsrYieldScope& scope);
+
+    // Destructor: Gives the semaphore back
+    ~IsrSemaphoreGuard();
+
+    // Delete copy constructor and copy assignment to prevent double-release
+    IsrSemaphoreGuard(const IsrSemaphoreGuard&) = delete;
+    IsrSemaphoreGuard& operator=(const IsrSemaphoreGuard&) = delete;
+
+    // Delete move constructor and move assignment for safety
+    IsrSemaphoreGuard(IsrSemaphoreGuard&&) = delete;
+    IsrSemaphoreGuard& operator=(IsrSemaphoreGuard&&) = delete;
+
+    // Check if the semaphore was successfully acquired
+    [[nodiscard]] bool hasLock() const noexcept { return m_taken; }
+
+    // Get the semaphore handle (for advanced use cases)
+    [[nodiscard]] SemaphoreHandle_t getHandle() const noexcept { return m_handle; }
+
+    // Check if this guard is valid (has non-null handle)
+    [[nodiscard]] bool isValid() const noexcept { return m_handle != nullptr; }
+
+private:
+    SemaphoreHandle_t m_handle;
+    bool m_taken;        // Indicates whether the semaphore was successfully taken
+    bool m_ownsYield;    // No scope given: yield from the destructor
+    BaseType_t m_ownWoken;
+    BaseType_t* m_woken; // Either &m_ownWoken or the scope's flag
+};
+
+#endif  // _ISR_SEMAPHORE_GUARD_H_
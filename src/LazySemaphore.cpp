@@ -0,0 +1,45 @@
+#include "LazySemaphore.h"
+
+LazySemaphore::~LazySemaphore() {
+    SemaphoreHandle_t handle = m_handle.load(std::memory_order_acquire);
+    if (handle != nullptr) {
+        vSemaphoreDelete(handle);
+    }
+}
+
+SemaphoreHandle_t LazySemaphore::create() const {
+    SemaphoreHandle_t candidate = nullptr;
+    switch (m_type) {
+        case Type::Mutex:
+            candidate = xSemaphoreCreateMutex();
+            break;
+        case Type::RecursiveMutex:
+            candidate = xSemaphoreCreateRecursiveMutex();
+            break;
+        case Type::Binary:
+            candidate = xSemaphoreCreateBinary();
+            break;
+        case Type::Counting:
+            candidate = xSemaphoreCreateCounting(m_maxCount, m_initialCount);
+            break;
+    }
+
+    if (candidate == nullptr) {
+        LAZY_LOG_E("Failed to create semaphore on first use");
+        // Another task may still have succeeded
+        return m_handle.load(std::memory_order_acquire);
+    }
+
+    // Publish our candidate unless another task beat us to it
+    SemaphoreHandle_t expected = nullptr;
+    if (m_handle.compare_exchange_strong(expected, candidate,
+                                         std::memory_order_acq_rel,
+                                         std::memory_order_acquire)) {
+        LAZY_LOG_D("Created semaphore %p on first use", candidate);
+        return candidate;
+    }
+
+    // Lost the race; nobody else has seen our candidate
+    vSemaphoreDelete(candidate);
+    return expected;
+}
@@ -0,0 +1,72 @@
+#ifndef _LAZY_SEMAPHORE_H_
+#define _LAZY_SEMAPHORE_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <atomic>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+
+// Semaphore handle that creates its FreeRTOS object on first use.
+//
+// Declaring a module-level lock costs a few bytes of .bss and no boot time;
+// the kernel object is only allocated when a guard first takes it, so
+// modules that never run never pay for their mutexes. The constructors are
+// constexpr, so module-level instances are constant-initialised and safe to
+// use from other static constructors.
+//
+//     static LazySemaphore xConfigMutex;                       // Mutex
+//     static LazySemaphore xLogMutex(LazySemaphore::Type::RecursiveMutex);
+//     static LazySemaphore xPool(4, 4);                        // Counting
+//
+//     SEMAPHORE_GUARD(xConfigMutex);
+//
+// Creation is race-free without a global lock: concurrent first users each
+// create a candidate, one compare-and-swap publishes the winner and the
+// losers delete theirs. Not for use from ISRs before the first task use.
+class LazySemaphore {
+public:
+    enum class Type : uint8_t { Mutex, RecursiveMutex, Binary, Counting };
+
+    // Constructor: Mutex, or a recursive mutex / binary semaphore
+    constexpr explicit LazySemaphore(Type type = Type::Mutex) noexcept
+        : m_handle(nullptr), m_type(type), m_maxCount(1), m_initialCount(0) {}
+
+    // Constructor: Counting semaphore
+    constexpr LazySemaphore(UBaseType_t maxCount, UBaseType_t initialCount) noexcept
+        : m_handle(nullptr), m_type(Type::Counting), m_maxCount(maxCount), m_initialCount(initialCount) {}
+
+    // Destructor: Deletes the semaphore if it was ever created
+    ~LazySemaphore();
+
+    // Delete copy and move; guards may hold the handle
+    LazySemaphore(const LazySemaphore&) = delete;
+    LazySemaphore& operator=(const LazySemaphore&) = delete;
+    LazySemaphore(LazySemaphore&&) = delete;
+    LazySemaphore& operator=(LazySemaphore&&) = delete;
+
+    // Get the semaphore handle, creating it on first call. Returns nullptr
+    // if creation failed; guards then report a null handle
+    [[nodiscard]] SemaphoreHandle_t get() const {
+        SemaphoreHandle_t handle = m_handle.load(std::memory_order_acquire);
+        return handle != nullptr ? handle : create();
+    }
+    operator SemaphoreHandle_t() const { return get(); }
+
+    // Check if the kernel object exists yet
+    [[nodiscard]] bool isCreated() const noexcept {
+        return m_handle.load(std::memory_order_acquire) != nullptr;
+    }
+
+    [[nodiscard]] Type type() const noexcept { return m_type; }
+
+private:
+    SemaphoreHandle_t create() const;
+
+    mutable std::atomic<SemaphoreHandle_t> m_handle;
+    Type m_type;
+    UBaseType_t m_maxCount;
+    UBaseType_t m_initialCount;
+};
+
+#endif  // _LAZY_SEMAPHORE_H_
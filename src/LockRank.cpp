@@ -0,0 +1,35 @@
+// Built into every application; the missing-slot warning is for users
+#define SEMAPHORE_GUARD_LOCK_RANK_IMPL
+#include "LockRank.h"
+#include <atomic>
+
+static std::atomic<uint32_t> s_violations{0};
+
+unsigned LockRankTracker::held() {
+    void* value = pvTaskGetThreadLocalStoragePointer(nullptr, SEMAPHORE_GUARD_RANK_TLS_INDEX);
+    return static_cast<unsigned>(reinterpret_cast<uintptr_t>(value));
+}
+
+void LockRankTracker::setHeld(unsigned rank) {
+    vTaskSetThreadLocalStoragePointer(nullptr, SEMAPHORE_GUARD_RANK_TLS_INDEX,
+                                      reinterpret_cast<void*>(static_cast<uintptr_t>(rank)));
+}
+
+bool LockRankTracker::admit(unsigned rank, const char* file, int line) {
+    const unsigned current = held();
+    if (rank > current) {
+        return true;
+    }
+
+    s_violations.fetch_add(1, std::memory_order_relaxed);
+    if (file != nullptr) {
+        RANK_LOG_E("Rank %u taken while holding rank %u at %s:%d", rank, current, file, line);
+    } else {
+        RANK_LOG_E("Rank %u taken while holding rank %u", rank, current);
+    }
+    return false;
+}
+
+uint32_t LockRankTracker::violations() {
+    return s_violations.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,216 @@
+#ifndef _LOCK_RANK_H_
+#define _LOCK_RANK_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+
+#include <type_traits>
+
+// Thread-local storage slot holding each task's highest held rank. ESP-IDF
+// uses slot 0 for pthreads, so the last slot is the default. The stock
+// CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS=1 leaves no slot; raise it
+// to at least 2 for runtime rank checks
+#ifndef SEMAPHORE_GUARD_RANK_TLS_INDEX
+#define SEMAPHORE_GUARD_RANK_TLS_INDEX (configNUM_THREAD_LOCAL_STORAGE_POINTERS - 1)
+#endif
+
+// Runtime rank checks: on unless NDEBUG is defined or no slot is free.
+// With 0 the guards do nothing beyond take and give, and no thread-local
+// storage is used
+#ifndef SEMAPHORE_GUARD_RANK_CHECKS
+#if defined(NDEBUG)
+#define SEMAPHORE_GUARD_RANK_CHECKS 0
+#elif SEMAPHORE_GUARD_RANK_TLS_INDEX < 1
+#ifndef SEMAPHORE_GUARD_LOCK_RANK_IMPL  // Only where ranked locks are used
+#warning "LockRank: no free thread-local storage slot, runtime rank checks are off; raise CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS or define SEMAPHORE_GUARD_RANK_CHECKS=0"
+#endif
+#define SEMAPHORE_GUARD_RANK_CHECKS 0
+#else
+#define SEMAPHORE_GUARD_RANK_CHECKS 1
+#endif
+#endif
+
+#if SEMAPHORE_GUARD_RANK_CHECKS
+static_assert(SEMAPHORE_GUARD_RANK_TLS_INDEX >= 1 &&
+              SEMAPHORE_GUARD_RANK_TLS_INDEX < configNUM_THREAD_LOCAL_STORAGE_POINTERS,
+              "SEMAPHORE_GUARD_RANK_TLS_INDEX must be a thread-local storage slot other than "
+              "pthread's slot 0; raise CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS");
+#endif
+
+// Per-task record of the highest rank held, used by the runtime check
+class LockRankTracker {
+public:
+    // Highest rank the calling task holds; 0 when it holds no ranked lock
+    [[nodiscard]] static unsigned held();
+
+    // Set the calling task's highest held rank
+    static void setHeld(unsigned rank);
+
+    // Check that rank is above everything the task holds; logs and counts
+    // a violation otherwise
+    [[nodiscard]] static bool admit(unsigned rank, const char* file, int line);
+
+    // Out-of-order acquisitions rejected so far
+    [[nodiscard]] static uint32_t violations();
+};
+
+// A semaphore with a lock hierarchy rank.
+//
+// Locks must be taken in strictly increasing rank. If every task follows
+// the order, no cycle of waiting tasks can form, so ranked locks cannot
+// deadlock on each other. The rank is part of the type:
+//
+//     static RankedLock<10> gConfigLock;
+//     static RankedLock<20> gBusLock;
+//
+// Non-owning, like TypedSemaphoreHandle. Ranks start at 1; 0 means "no
+// ranked lock held". Not for recursive mutexes: taking the same rank
+// twice is a violation.
+template <unsigned Rank>
+class RankedLock {
+public:
+    static_assert(Rank > 0, "Lock ranks start at 1");
+    static constexpr unsigned rank = Rank;
+
+    constexpr RankedLock() noexcept : m_handle(nullptr) {}
+    constexpr explicit RankedLock(SemaphoreHandle_t handle) noexcept : m_handle(handle) {}
+
+    // Get the raw handle for FreeRTOS calls
+    [[nodiscard]] SemaphoreHandle_t get() const noexcept { return m_handle; }
+
+    // Check if this lock is valid (non-null)
+    [[nodiscard]] bool isValid() const noexcept { return m_handle != nullptr; }
+
+private:
+    SemaphoreHandle_t m_handle;
+};
+
+// RAII guard for RankedLock.
+//
+// Nesting that is visible in one scope is checked at compile time by
+// passing the enclosing guard:
+//
+//     RankedGuard<10> config(gConfigLock);
+//     RankedGuard<20> bus(gBusLock, config);     // OK
+//     RankedGuard<5>  bad(gOtherLock, config);   // Compile error
+//
+// Every constructor also compares the rank with the highest rank the task
+// holds, which covers locks taken by callers, and refuses to take the lock
+// on a violation, reporting hasLock() == false. A nested guard also refuses
+// when the enclosing guard does not hold its lock. That check
+// costs one thread-local read and write per guard and compiles out with
+// SEMAPHORE_GUARD_RANK_CHECKS=0. Guards must be released in reverse order,
+// which scoping gives.
+template <unsigned Rank>
+class RankedGuard {
+public:
+    // Constructor: Checks the rank at runtime, then waits with the given timeout
+    explicit RankedGuard(const RankedLock<Rank>& lock, TickType_t timeout = portMAX_DELAY)
+        : m_handle(lock.get()), m_taken(false) {
+        acquire(timeout, nullptr, 0);
+    }
+
+    // Constructor: Nested inside outer; the order of the two ranks is
+    // checked at compile time, the ranks held by callers at runtime
+    template <unsigned Outer>
+    RankedGuard(const RankedLock<Rank>& lock, const RankedGuard<Outer>& outer, TickType_t timeout = portMAX_DELAY)
+        : m_handle(lock.get()), m_taken(false) {
+        static_assert(Rank > Outer, "Lock rank order violated: take locks in increasing rank");
+        if (!outer.hasLock()) {
+            RANK_LOG_E("Enclosing rank %u guard does not hold its lock", Outer);
+            return;
+        }
+        acquire(timeout, nullptr, 0);
+    }
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+    // Debug constructors with file/line info for violation reports
+    RankedGuard(const RankedLock<Rank>& lock, const char* file, int line)
+        : m_handle(lock.get()), m_taken(false) {
+        acquire(portMAX_DELAY, file, line);
+    }
+
+    RankedGuard(const RankedLock<Rank>& lock, TickType_t timeout, const char* file, int line)
+        : m_handle(lock.get()), m_taken(false) {
+        acquire(timeout, file, line);
+    }
+#endif
+
+    // Destructor: Gives the semaphore back and restores the task's held rank
+    ~RankedGuard() {
+        if (m_taken) {
+            xSemaphoreGive(m_handle);
+#if SEMAPHORE_GUARD_RANK_CHECKS
+            LockRankTracker::setHeld(m_previous);
+#endif
+        }
+    }
+
+    // Delete copy constructor and copy assignment to prevent double-release
+    RankedGuard(const RankedGuard&) = delete;
+    RankedGuard& operator=(const RankedGuard&) = delete;
+
+    // Delete move constructor and move assignment for safety
+    RankedGuard(RankedGuard&&) = delete;
+    RankedGuard& operator=(RankedGuard&&) = delete;
+
+    // Check if the semaphore was successfully acquired
+    [[nodiscard]] bool hasLock() const noexcept { return m_taken; }
+
+    // Get the semaphore handle (for advanced use cases)
+    [[nodiscard]] SemaphoreHandle_t getHandle() const noexcept { return m_handle; }
+
+    // Rank of the guarded lock
+    [[nodiscard]] static constexpr unsigned rank() noexcept { return Rank; }
+
+private:
+    void acquire(TickType_t timeout, const char* file, int line) {
+        if (m_handle == nullptr) {
+            RANK_LOG_E("Lock handle is null");
+            return;
+        }
+        if (xPortInIsrContext()) {
+            RANK_LOG_E("Cannot use RankedGuard in ISR context");
+            return;
+        }
+#if SEMAPHORE_GUARD_RANK_CHECKS
+        if (!LockRankTracker::admit(Rank, file, line)) {
+            return;
+        }
+        m_previous = LockRankTracker::held();
+#else
+        (void)file;
+        (void)line;
+#endif
+        m_taken = (xSemaphoreTake(m_handle, timeout) == pdTRUE);
+#if SEMAPHORE_GUARD_RANK_CHECKS
+        if (m_taken) {
+            // Never lower the held rank
+            LockRankTracker::setHeld(m_previous > Rank ? m_previous : Rank);
+        }
+#endif
+    }
+
+    SemaphoreHandle_t m_handle;
+    bool m_taken;  // Indicates whether the semaphore was successfully taken
+#if SEMAPHORE_GUARD_RANK_CHECKS
+    unsigned m_previous = 0;  // Held rank to restore on release
+#endif
+};
+
+// Guard type for a RankedLock expression, without C++17 deduction
+#define RANKED_GUARD_TYPE(lock) RankedGuard<std::decay<decltype(lock)>::type::rank>
+
+// Macro for debug support; the rank is taken from the lock's type
+#ifdef SEMAPHORE_GUARD_DEBUG
+    #define RANKED_GUARD(lock) RANKED_GUARD_TYPE(lock) guard(lock, __FILE__, __LINE__)
+    #define RANKED_GUARD_TIMEOUT(lock, timeout) RANKED_GUARD_TYPE(lock) guard(lock, timeout, __FILE__, __LINE__)
+#else
+    #define RANKED_GUARD(lock) RANKED_GUARD_TYPE(lock) guard(lock)
+    #define RANKED_GUARD_TIMEOUT(lock, timeout) RANKED_GUARD_TYPE(lock) guard(lock, timeout)
+#endif
+
+#endif  // _LOCK_RANK_H_
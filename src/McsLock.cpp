@@ -0,0 +1,184 @@
+#include "McsLock.h"
+
+static McsLock::Node s_nodePool[MCS_LOCK_NODE_POOL_SIZE];
+static std::atomic<bool> s_nodeUsed[MCS_LOCK_NODE_POOL_SIZE];
+
+static int poolIndex(const McsLock::Node& node) {
+    const uintptr_t address = reinterpret_cast<uintptr_t>(&node);
+    const uintptr_t first = reinterpret_cast<uintptr_t>(&s_nodePool[0]);
+    if (address < first || address >= first + sizeof(s_nodePool)) {
+        return -1;
+    }
+    return static_cast<int>((address - first) / sizeof(McsLock::Node));
+}
+
+bool McsLock::lock(Node& node, TickType_t timeout) {
+    if (xPortInIsrContext()) {
+        MCS_LOG_E("Cannot use McsLock in ISR context");
+        return false;
+    }
+    if (node.state.load(std::memory_order_acquire) != Idle) {
+        MCS_LOG_E("Queue node is still in use");
+        return false;
+    }
+
+    node.next.store(nullptr, std::memory_order_relaxed);
+    node.task = xTaskGetCurrentTaskHandle();
+
+    if (timeout == 0) {
+        // Never queue for a try-lock, so nothing is left to abandon
+        Node* expected = nullptr;
+        if (m_tail.compare_exchange_strong(expected, &node, std::memory_order_acq_rel)) {
+            node.state.store(Granted, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    node.state.store(Spinning, std::memory_order_relaxed);
+    Node* prev = m_tail.exchange(&node, std::memory_order_acq_rel);
+    if (prev == nullptr) {
+        node.state.store(Granted, std::memory_order_relaxed);
+        return true;
+    }
+
+    // The predecessor stays alive until it has seen this link: even an
+    // abandoned one is only released after its successor is known
+    prev->next.store(&node, std::memory_order_release);
+    return wait(node, timeout);
+}
+
+bool McsLock::wait(Node& node, TickType_t timeout) {
+    for (int i = 0; i < MCS_LOCK_SPIN_LIMIT; i++) {
+        if (node.state.load(std::memory_order_acquire) == Granted) {
+            return true;
+        }
+    }
+
+    uint8_t expected = Spinning;
+    if (!node.state.compare_exchange_strong(expected, Sleeping, std::memory_order_acq_rel)) {
+        return true;
+    }
+
+    TimeOut_t start;
+    vTaskSetTimeOutState(&start);
+    TickType_t remaining = timeout;
+    bool notified = false;  // Set once a take returned a notification
+    while (true) {
+        notified = ulTaskNotifyTake(pdTRUE, remaining) != 0;
+        if (node.state.load(std::memory_order_acquire) == Granted) {
+            return consumeGrant(notified);
+        }
+        if (timeout != portMAX_DELAY && xTaskCheckForTimeOut(&start, &remaining) == pdTRUE) {
+            break;
+        }
+    }
+
+    // Give up our turn; the owner that reaches this node will skip it
+    expected = Sleeping;
+    if (node.state.compare_exchange_strong(expected, Abandoned, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    // Granted as the timeout expired: we own the lock
+    return consumeGrant(false);
+}
+
+bool McsLock::consumeGrant(bool notified) {
+    // Every grant of a sleeping node is followed by a give from unlock(). If
+    // the last take did not return it, it is still on its way and must be
+    // consumed so it cannot wake a later wait
+    if (!notified) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    return true;
+}
+
+void McsLock::unlock(Node& node) {
+    Node* current = &node;
+    while (true) {
+        Node* next = current->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            // No known successor: free the lock if current is still the tail
+            Node* expected = current;
+            if (m_tail.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel)) {
+                passed(*current);
+                return;
+            }
+            // A successor swapped itself in but has not linked yet
+            int spins = 0;
+            while ((next = current->next.load(std::memory_order_acquire)) == nullptr) {
+                if (++spins >= MCS_LOCK_SPIN_LIMIT) {
+                    // It may be preempted on this core; let it run
+                    vTaskDelay(1);
+                    spins = 0;
+                }
+            }
+        }
+
+        // Done with current; an abandoned node's guard may now go away
+        passed(*current);
+
+        // Read the task before granting: the successor may return and
+        // reuse its stack as soon as it sees Granted
+        const TaskHandle_t task = next->task;
+        uint8_t state = next->state.load(std::memory_order_acquire);
+        while (state == Spinning || state == Sleeping) {
+            if (next->state.compare_exchange_weak(state, Granted, std::memory_order_acq_rel)) {
+                if (state == Sleeping) {
+                    xTaskNotifyGive(task);
+                }
+                return;
+            }
+        }
+
+        // Successor abandoned its turn; pass through it to the next one
+        current = next;
+    }
+}
+
+void McsLock::waitReleased(Node& node) {
+    // Only abandoned nodes are still queued after a failed lock()
+    while (node.state.load(std::memory_order_acquire) == Abandoned) {
+        vTaskDelay(1);
+    }
+}
+
+void McsLock::passed(Node& node) {
+    // An orphaned node's guard is gone, so return the node to the pool here
+    if (node.state.exchange(Idle, std::memory_order_acq_rel) == Orphaned) {
+        freePooled(node);
+    }
+}
+
+McsLock::Node* McsLock::acquireNode(Node& fallback) {
+    for (int i = 0; i < MCS_LOCK_NODE_POOL_SIZE; i++) {
+        bool expected = false;
+        if (!s_nodeUsed[i].load(std::memory_order_relaxed) &&
+            s_nodeUsed[i].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return &s_nodePool[i];
+        }
+    }
+    return &fallback;
+}
+
+void McsLock::releaseNode(Node& node) {
+    if (poolIndex(node) < 0) {
+        waitReleased(node);
+        return;
+    }
+    // Still queued: the owner that skips the node returns it to the pool
+    uint8_t expected = Abandoned;
+    if (node.state.compare_exchange_strong(expected, Orphaned, std::memory_order_acq_rel)) {
+        return;
+    }
+    freePooled(node);
+}
+
+void McsLock::freePooled(Node& node) {
+    s_nodeUsed[poolIndex(node)].store(false, std::memory_order_release);
+}
+
+bool McsLock::isAbandoned(const Node& node) noexcept {
+    return node.state.load(std::memory_order_acquire) == Abandoned;
+}
@@ -0,0 +1,167 @@
+#ifndef _MCS_LOCK_H_
+#define _MCS_LOCK_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "Deadline.h"
+
+// Number of polls of a waiter's own node before it blocks
+#ifndef MCS_LOCK_SPIN_LIMIT
+#define MCS_LOCK_SPIN_LIMIT 100
+#endif
+
+// Queue nodes shared by all McsLockGuards. A guard that times out leaves
+// its pooled node behind for the owner to skip and return to the pool
+#ifndef MCS_LOCK_NODE_POOL_SIZE
+#define MCS_LOCK_NODE_POOL_SIZE 8
+#endif
+
+// MCS queue lock.
+//
+// The lock itself is a single tail pointer touched once per acquisition
+// (an atomic exchange) and once per uncontended release. Each waiter spins
+// on, and is woken through, its own queue node, so under cross-core
+// contention the cores do not keep bouncing one shared lock word between
+// their caches. Waiters spin for MCS_LOCK_SPIN_LIMIT polls, then block on
+// their task notification. Ownership passes in FIFO order.
+//
+// Timeouts: a waiter that times out marks its node abandoned and reports
+// failure, but the node keeps its place in the queue. The owner that
+// eventually reaches it skips over it, so the node must stay alive until
+// then. McsLockGuard takes its node from a pool of MCS_LOCK_NODE_POOL_SIZE
+// and hands an abandoned node over to the queue, so its destructor returns
+// at once; the owner that skips the node puts it back in the pool. Only if
+// the pool is exhausted does a guard use a node on its own stack, and its
+// destructor then waits for the lock to pass the abandoned position.
+//
+// No priority inheritance, not recursive, not for ISRs. Waiting uses the
+// task's default notification slot.
+class McsLock {
+public:
+    // Queue node; idle until passed to lock()
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        std::atomic<uint8_t> state{0};  // McsLock::Idle
+        TaskHandle_t task = nullptr;
+    };
+
+    McsLock() : m_tail(nullptr) {}
+
+    // Delete copy and move; queued nodes refer to this instance
+    McsLock(const McsLock&) = delete;
+    McsLock& operator=(const McsLock&) = delete;
+    McsLock(McsLock&&) = delete;
+    McsLock& operator=(McsLock&&) = delete;
+
+    // Queue node and wait up to timeout ticks. On false the node may still
+    // be queued as abandoned; call waitReleased(node) before reusing or
+    // destroying it
+    bool lock(Node& node, TickType_t timeout = portMAX_DELAY);
+
+    // Release; node must be the one passed to the successful lock()
+    void unlock(Node& node);
+
+    // Block until an abandoned node has been skipped by the queue
+    static void waitReleased(Node& node);
+
+    // Node from the shared pool, or fallback if every pooled node is in use
+    static Node* acquireNode(Node& fallback);
+
+    // Return a node from acquireNode(). An abandoned pooled node is left to
+    // the queue, which returns it once skipped; a fallback node is waited for
+    static void releaseNode(Node& node);
+
+    // Check if a node is still linked into the queue after a timeout
+    [[nodiscard]] static bool isAbandoned(const Node& node) noexcept;
+
+    // Check if any task holds or waits for the lock
+    [[nodiscard]] bool isLocked() const noexcept { return m_tail.load(std::memory_order_acquire) != nullptr; }
+
+private:
+    // Idle is also the state of a node the queue is done with. Orphaned: an
+    // abandoned pooled node whose guard is gone
+    enum State : uint8_t { Idle, Spinning, Sleeping, Granted, Abandoned, Orphaned };
+
+    bool wait(Node& node, TickType_t timeout);
+    static bool consumeGrant(bool notified);
+    static void passed(Node& node);
+    static void freePooled(Node& node);
+
+    std::atomic<Node*> m_tail;
+};
+
+// RAII guard for McsLock with the same shape as SemaphoreGuard. Uses a
+// pooled queue node, falling back to one inside the guard
+class McsLockGuard {
+public:
+    // Constructor: Waits for the lock without limit
+    explicit McsLockGuard(McsLock& lock)
+        : m_node(McsLock::acquireNode(m_fallback)), m_lock(lock), m_taken(lock.lock(*m_node, portMAX_DELAY)) {}
+
+    // Constructor: Waits for the lock at most timeout ticks
+    McsLockGuard(McsLock& lock, TickType_t timeout)
+        : m_node(McsLock::acquireNode(m_fallback)), m_lock(lock), m_taken(lock.lock(*m_node, timeout)) {}
+
+    // Constructor: Waits using only the time left before the deadline
+    McsLockGuard(McsLock& lock, const Deadline& deadline)
+        : m_node(McsLock::acquireNode(m_fallback)), m_lock(lock),
+          m_taken(lock.lock(*m_node, deadline.remaining())) {}
+
+    // Destructor: Releases the lock and returns the node
+    ~McsLockGuard() {
+        if (m_taken) {
+            m_lock.unlock(*m_node);
+        }
+        McsLock::releaseNode(*m_node);
+    }
+
+    // Delete copy constructor and copy assignment to prevent double-release
+    McsLockGuard(const McsLockGuard&) = delete;
+    McsLockGuard& operator=(const McsLockGuard&) = delete;
+
+    // Delete move constructor and move assignment; the node is linked by address
+    McsLockGuard(McsLockGuard&&) = delete;
+    McsLockGuard& operator=(McsLockGuard&&) = delete;
+
+    // Check if the lock was successfully acquired
+    [[nodiscard]] bool hasLock() const noexcept { return m_taken; }
+
+    // Get the lock (for advanced use cases)
+    [[nodiscard]] McsLock& getLock() const noexcept { return m_lock; }
+
+    // Release early; the destructor then does nothing unless lock() is called
+    void unlock() {
+        if (m_taken) {
+            m_lock.unlock(*m_node);
+            m_taken = false;
+        }
+    }
+
+    // Take the lock again after unlock() or a timeout; returns hasLock()
+    bool lock(TickType_t timeout = portMAX_DELAY) {
+        if (!m_taken) {
+            if (McsLock::isAbandoned(*m_node)) {
+                // Leave the abandoned node to the queue and queue a fresh one
+                McsLock::releaseNode(*m_node);
+                m_node = McsLock::acquireNode(m_fallback);
+            }
+            m_taken = m_lock.lock(*m_node, timeout);
+        }
+        return m_taken;
+    }
+
+private:
+    // Declared before m_taken: the constructors pass them to McsLock::lock()
+    McsLock::Node m_fallback;
+    McsLock::Node* m_node;
+    McsLock& m_lock;
+    bool m_taken;  // Indicates whether the lock was successfully taken
+};
+
+#define MCS_LOCK_GUARD(lock) McsLockGuard guard(lock)
+#define MCS_LOCK_GUARD_TIMEOUT(lock, timeout) McsLockGuard guard(lock, timeout)
+
+#endif  // _MCS_LOCK_H_
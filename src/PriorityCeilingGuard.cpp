@@ -0,0 +1,95 @@
+#include "PriorityCeilingGuard.h"
+
+// Priority of the task without priority inheritance. Restoring a priority
+// inherited through a held mutex would make it the task's own. Without the
+// trace facility the current priority is the best available
+static UBaseType_t basePriority(TaskHandle_t task) {
+#if configUSE_TRACE_FACILITY && configUSE_MUTEXES
+    TaskStatus_t status;
+    vTaskGetInfo(task, &status, pdFALSE, eRunning);
+    return status.uxBasePriority;
+#else
+    return uxTaskPriorityGet(task);
+#endif
+}
+
+PriorityBoost::PriorityBoost(UBaseType_t priority)
+    : m_task(nullptr), m_previous(0), m_ceiling(0), m_raised(false) {
+    // vTaskPrioritySet() is task-only; SemaphoreGuard reports the ISR misuse
+    if (xPortInIsrContext()) {
+        return;
+    }
+    if (priority >= configMAX_PRIORITIES) {
+        PCG_LOG_W("Ceiling %u clamped to %u", (unsigned)priority, (unsigned)(configMAX_PRIORITIES - 1));
+        priority = configMAX_PRIORITIES - 1;
+    }
+
+    m_task = xTaskGetCurrentTaskHandle();
+    m_previous = basePriority(m_task);
+    if (priority > m_previous) {
+        // Sets the base priority; an inherited one above it stays in force
+        vTaskPrioritySet(m_task, priority);
+        m_ceiling = priority;
+        m_raised = true;
+    }
+}
+
+void PriorityBoost::restore() {
+    if (!m_raised) {
+        return;
+    }
+    m_raised = false;
+    // Changed by someone else while boosted (or, without the trace
+    // facility, inherited at the moment): leave it rather than overwrite it
+    const UBaseType_t current = basePriority(m_task);
+    if (current != m_ceiling) {
+        PCG_LOG_W("Priority is %u, not the ceiling %u; previous %u not restored",
+                  (unsigned)current, (unsigned)m_ceiling, (unsigned)m_previous);
+        return;
+    }
+    vTaskPrioritySet(m_task, m_previous);
+}
+
+PriorityCeilingGuard::PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling)
+    : m_boost(ceiling), m_guard(handle) {
+    finish();
+}
+
+PriorityCeilingGuard::PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling, TickType_t timeout)
+    : m_boost(ceiling), m_guard(handle, timeout) {
+    finish();
+}
+
+PriorityCeilingGuard::PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling, const Deadline& deadline)
+    : m_boost(ceiling), m_guard(handle, deadline) {
+    finish();
+}
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+PriorityCeilingGuard::PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling,
+                                           const char* file, int line)
+    : m_boost(ceiling), m_guard(handle, file, line) {
+    finish();
+    if (m_boost.isRaised()) {
+        PCG_LOG_D("Raised priority %u -> %u at %s:%d",
+                  (unsigned)m_boost.previous(), (unsigned)ceiling, file, line);
+    }
+}
+
+PriorityCeilingGuard::PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling, TickType_t timeout,
+                                           const char* file, int line)
+    : m_boost(ceiling), m_guard(handle, timeout, file, line) {
+    finish();
+    if (m_boost.isRaised()) {
+        PCG_LOG_D("Raised priority %u -> %u at %s:%d",
+                  (unsigned)m_boost.previous(), (unsigned)ceiling, file, line);
+    }
+}
+#endif
+
+void PriorityCeilingGuard::finish() {
+    // Nothing to protect: drop back to the normal priority right away
+    if (!m_guard.hasLock()) {
+        m_boost.restore();
+    }
+}
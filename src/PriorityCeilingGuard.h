@@ -0,0 +1,137 @@
+#ifndef _PRIORITY_CEILING_GUARD_H_
+#define _PRIORITY_CEILING_GUARD_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "SemaphoreGuard.h"
+
+// Raises the calling task to at least a given priority for the lifetime of
+// the object and restores the previous priority afterwards. Never lowers
+// the priority. Nested boosts restore correctly as long as they end in
+// reverse order, which RAII scoping guarantees.
+//
+// The previous priority is the task's base priority, read with
+// vTaskGetInfo() when configUSE_TRACE_FACILITY is set, so a priority
+// inherited through a held mutex is never restored as the task's own.
+// Without the trace facility only uxTaskPriorityGet() is available, and it
+// may return an inherited value. Either way the priority is restored only
+// if it still is the ceiling this object set; otherwise a warning is
+// logged and the priority left as it is.
+class PriorityBoost {
+public:
+    explicit PriorityBoost(UBaseType_t priority);
+
+    // Destructor: Restores the previous priority if it was raised
+    ~PriorityBoost() { restore(); }
+
+    // Delete copy and move; the boost belongs to one scope
+    PriorityBoost(const PriorityBoost&) = delete;
+    PriorityBoost& operator=(const PriorityBoost&) = delete;
+    PriorityBoost(PriorityBoost&&) = delete;
+    PriorityBoost& operator=(PriorityBoost&&) = delete;
+
+    // Restore early; the destructor then does nothing
+    void restore();
+
+    // Check if the priority was changed
+    [[nodiscard]] bool isRaised() const noexcept { return m_raised; }
+
+    // Priority before the boost
+    [[nodiscard]] UBaseType_t previous() const noexcept { return m_previous; }
+
+private:
+    TaskHandle_t m_task;
+    UBaseType_t m_previous;
+    UBaseType_t m_ceiling;  // Priority set by this boost
+    bool m_raised;
+};
+
+// A lock together with its ceiling: the highest priority of any task that
+// takes it
+struct CeilingLock {
+    SemaphoreHandle_t handle;
+    UBaseType_t ceiling;
+};
+
+// Immediate priority ceiling protocol on top of SemaphoreGuard.
+//
+// The holder runs at the lock's ceiling priority from before the take
+// until after the give, so no task that uses the lock can preempt it and
+// medium-priority tasks cannot delay its release. Blocking of a
+// high-priority task is then bounded by the longest single critical
+// section, for binary semaphores too, which have no priority inheritance.
+//
+//     static const CeilingLock kBusLock = {xBusSemaphore, CONTROL_TASK_PRIORITY};
+//     PRIORITY_CEILING_GUARD(kBusLock);
+//
+// If the lock cannot be taken, the priority is restored immediately.
+class PriorityCeilingGuard {
+public:
+    // Constructor: Raises to ceiling and takes the semaphore without limit
+    PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling);
+
+    // Constructor: Raises to ceiling and takes the semaphore with a provided timeout
+    PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling, TickType_t timeout);
+
+    // Constructor: Raises to ceiling and takes the semaphore within the deadline
+    PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling, const Deadline& deadline);
+
+    // Constructors taking a CeilingLock
+    explicit PriorityCeilingGuard(const CeilingLock& lock) : PriorityCeilingGuard(lock.handle, lock.ceiling) {}
+    PriorityCeilingGuard(const CeilingLock& lock, TickType_t timeout)
+        : PriorityCeilingGuard(lock.handle, lock.ceiling, timeout) {}
+
+#ifdef SEMAPHORE_GUARD_DEBUG
+    // Debug constructors with file/line info
+    PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling, const char* file, int line);
+    PriorityCeilingGuard(SemaphoreHandle_t handle, UBaseType_t ceiling, TickType_t timeout,
+                         const char* file, int line);
+    PriorityCeilingGuard(const CeilingLock& lock, const char* file, int line)
+        : PriorityCeilingGuard(lock.handle, lock.ceiling, file, line) {}
+    PriorityCeilingGuard(const CeilingLock& lock, TickType_t timeout, const char* file, int line)
+        : PriorityCeilingGuard(lock.handle, lock.ceiling, timeout, file, line) {}
+#endif
+
+    // Destructor: m_guard gives the semaphore back, then m_boost restores the priority
+
+    // Delete copy constructor and copy assignment to prevent double-release
+    PriorityCeilingGuard(const PriorityCeilingGuard&) = delete;
+    PriorityCeilingGuard& operator=(const PriorityCeilingGuard&) = delete;
+
+    // Delete move constructor and move assignment for safety
+    PriorityCeilingGuard(PriorityCeilingGuard&&) = delete;
+    PriorityCeilingGuard& operator=(PriorityCeilingGuard&&) = delete;
+
+    // Check if the semaphore was successfully acquired
+    [[nodiscard]] bool hasLock() const noexcept { return m_guard.hasLock(); }
+
+    // Get the semaphore handle (for advanced use cases)
+    [[nodiscard]] SemaphoreHandle_t getHandle() const noexcept { return m_guard.getHandle(); }
+
+    // Check if this guard is valid (has non-null handle)
+    [[nodiscard]] bool isValid() const noexcept { return m_guard.isValid(); }
+
+    // Check if the task's priority was raised for this guard
+    [[nodiscard]] bool isBoosted() const noexcept { return m_boost.isRaised(); }
+
+private:
+    void finish();
+
+    // Declared first: raised before the take and restored after the give
+    PriorityBoost m_boost;
+    SemaphoreGuard m_guard;
+};
+
+// Macro for debug support; lock is a CeilingLock
+#ifdef SEMAPHORE_GUARD_DEBUG
+    #define PRIORITY_CEILING_GUARD(lock) PriorityCeilingGuard guard(lock, __FILE__, __LINE__)
+    #define PRIORITY_CEILING_GUARD_TIMEOUT(lock, timeout) PriorityCeilingGuard guard(lock, timeout, __FILE__, __LINE__)
+#else
+    #define PRIORITY_CEILING_GUARD(lock) PriorityCeilingGuard guard(lock)
+    #define PRIORITY_CEILING_GUARD_TIMEOUT(lock, timeout) PriorityCeilingGuard guard(lock, timeout)
+#endif
+
+#endif  // _PRIORITY_CEILING_GUARD_H_
@@ -0,0 +1,177 @@
+#ifndef _RCU_STORE_H_
+#define _RCU_STORE_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <atomic>
+
+#include "SemaphoreGuard.h"
+
+// Read-copy-update container for read-mostly data such as configuration.
+//
+// Readers take a ReadGuard, which only bumps a per-core counter for the
+// version they are reading; they never touch a semaphore and never block.
+// Writers build the new value in a spare version slot and publish it with a
+// single atomic store. A slot is reused only once every reader that entered
+// it has left (the grace period), so memory is bounded by Versions * sizeof(T).
+//
+// Writers are serialized with a SemaphoreGuard on an internal, statically
+// allocated mutex. If all spare slots are still pinned by readers, a writer
+// waits for them within its timeout.
+template <typename T, size_t Versions = 3>
+class RcuStore {
+    static_assert(Versions >= 2, "RcuStore needs at least two versions");
+
+public:
+    RcuStore() : RcuStore(T()) {}
+
+    explicit RcuStore(const T& initial) : m_current(0) {
+        for (size_t core = 0; core < portNUM_PROCESSORS; core++) {
+            for (size_t slot = 0; slot < Versions; slot++) {
+                m_readers[core][slot].store(0, std::memory_order_relaxed);
+            }
+        }
+        m_slots[0] = initial;
+        m_writeMutex = xSemaphoreCreateMutexStatic(&m_writeMutexBuffer);
+    }
+
+    ~RcuStore() {
+        if (m_writeMutex != nullptr) {
+            vSemaphoreDelete(m_writeMutex);
+        }
+    }
+
+    // Delete copy and move; guards refer to this instance
+    RcuStore(const RcuStore&) = delete;
+    RcuStore& operator=(const RcuStore&) = delete;
+    RcuStore(RcuStore&&) = delete;
+    RcuStore& operator=(RcuStore&&) = delete;
+
+    // Read-side critical section: the referenced version stays valid and
+    // unchanged for the lifetime of the guard. Lock-free and ISR-safe
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const RcuStore& store)
+            : m_store(store),
+              m_core(static_cast<uint8_t>(xPortGetCoreID())),
+              m_slot(store.enterRead(m_core)) {}
+
+        ~ReadGuard() { m_store.exitRead(m_core, m_slot); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+        ReadGuard(ReadGuard&&) = delete;
+        ReadGuard& operator=(ReadGuard&&) = delete;
+
+        const T& get() const noexcept { return m_store.m_slots[m_slot]; }
+        const T& operator*() const noexcept { return get(); }
+        const T* operator->() const noexcept { return &get(); }
+
+    private:
+        const RcuStore& m_store;
+        // The task may migrate while reading; leave on the counter we entered
+        const uint8_t m_core;
+        const uint8_t m_slot;
+    };
+
+    // Return a copy of the current version
+    [[nodiscard]] T read() const {
+        ReadGuard guard(*this);
+        return guard.get();
+    }
+
+    // Publish a new value. Returns false if the write mutex or a free version
+    // slot could not be obtained within the timeout
+    bool update(const T& value, TickType_t timeout = portMAX_DELAY) {
+        return publish(timeout, [&value](T& slot) { slot = value; });
+    }
+
+    // Copy the current version, apply fn(T&) to the copy and publish it
+    template <typename Fn>
+    bool modify(Fn fn, TickType_t timeout = portMAX_DELAY) {
+        return publish(timeout, [this, &fn](T& slot) {
+            slot = m_slots[m_current.load(std::memory_order_relaxed)];
+            fn(slot);
+        });
+    }
+
+    // Number of readers currently inside a read-side critical section
+    [[nodiscard]] uint32_t activeReaders() const noexcept {
+        uint32_t total = 0;
+        for (size_t slot = 0; slot < Versions; slot++) {
+            total += readersOf(slot);
+        }
+        return total;
+    }
+
+    // Fixed memory footprint of the stored versions
+    static constexpr size_t storageBytes() { return sizeof(T) * Versions; }
+
+private:
+    uint8_t enterRead(uint8_t core) const noexcept {
+        while (true) {
+            const uint8_t slot = m_current.load(std::memory_order_seq_cst);
+            m_readers[core][slot].fetch_add(1, std::memory_order_seq_cst);
+            // A writer may have retired this slot between the load and the
+            // increment; only keep the marker if the slot is still current
+            if (m_current.load(std::memory_order_seq_cst) == slot) {
+                return slot;
+            }
+            m_readers[core][slot].fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    void exitRead(uint8_t core, uint8_t slot) const noexcept {
+        m_readers[core][slot].fetch_sub(1, std::memory_order_release);
+    }
+
+    uint32_t readersOf(size_t slot) const noexcept {
+        uint32_t total = 0;
+        for (size_t core = 0; core < portNUM_PROCESSORS; core++) {
+            total += m_readers[core][slot].load(std::memory_order_seq_cst);
+        }
+        return total;
+    }
+
+    // Find a non-current slot whose grace period has elapsed
+    int findFreeSlot() const noexcept {
+        const uint8_t current = m_current.load(std::memory_order_relaxed);
+        for (size_t slot = 0; slot < Versions; slot++) {
+            if (slot != current && readersOf(slot) == 0) {
+                return static_cast<int>(slot);
+            }
+        }
+        return -1;
+    }
+
+    template <typename Fill>
+    bool publish(TickType_t timeout, Fill fill) {
+        const TickType_t start = xTaskGetTickCount();
+        SemaphoreGuard guard(m_writeMutex, timeout);
+        if (!guard.hasLock()) {
+            return false;
+        }
+
+        int slot = findFreeSlot();
+        while (slot < 0) {
+            const TickType_t elapsed = xTaskGetTickCount() - start;
+            if (timeout != portMAX_DELAY && elapsed >= timeout) {
+                return false;
+            }
+            vTaskDelay(1);
+            slot = findFreeSlot();
+        }
+
+        fill(m_slots[slot]);
+        m_current.store(static_cast<uint8_t>(slot), std::memory_order_seq_cst);
+        return true;
+    }
+
+    T m_slots[Versions];
+    std::atomic<uint8_t> m_current;
+    mutable std::atomic<uint32_t> m_readers[portNUM_PROCESSORS][Versions];
+    StaticSemaphore_t m_writeMutexBuffer;
+    SemaphoreHandle_t m_writeMutex;
+};
+
+#endif  // _RCU_STORE_H_
@@ -0,0 +1,114 @@
+#include "RecursiveOwnership.h"
+#include "CriticalSectionGuard.h"
+
+static portMUX_TYPE s_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// Guarded by s_mux
+static RecursionStats s_stats[SEMAPHORE_GUARD_RECURSION_STATS];
+static size_t s_used = 0;
+
+void RecursiveOwnership::push(RecursiveOwnerNode& node, SemaphoreHandle_t handle) {
+    node.handle = handle;
+    node.depth = 1;
+    node.maxDepth = 1;
+    node.reentries = 0;
+    node.next = static_cast<RecursiveOwnerNode*>(
+        pvTaskGetThreadLocalStoragePointer(nullptr, SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX));
+    vTaskSetThreadLocalStoragePointer(nullptr, SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX, &node);
+}
+
+bool RecursiveOwnership::leave(RecursiveOwnerNode& node) {
+    if (--node.depth != 0) {
+        return false;
+    }
+    unlink(node);
+    if (node.maxDepth > 1) {
+        publish(node);
+    }
+    node.handle = nullptr;
+    return true;
+}
+
+void RecursiveOwnership::unlink(RecursiveOwnerNode& node) {
+    // Mutexes are normally released in reverse order, so this is the head
+    RecursiveOwnerNode* current = static_cast<RecursiveOwnerNode*>(
+        pvTaskGetThreadLocalStoragePointer(nullptr, SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX));
+    if (current == &node) {
+        vTaskSetThreadLocalStoragePointer(nullptr, SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX, node.next);
+    } else {
+        while (current != nullptr && current->next != &node) {
+            current = current->next;
+        }
+        if (current != nullptr) {
+            current->next = node.next;
+        }
+    }
+    node.next = nullptr;
+}
+
+void RecursiveOwnership::publish(const RecursiveOwnerNode& node) {
+    CriticalSectionGuard guard(&s_mux);
+    RecursionStats* entry = nullptr;
+    for (size_t i = 0; i < s_used; i++) {
+        if (s_stats[i].handle == node.handle) {
+            entry = &s_stats[i];
+            break;
+        }
+    }
+    if (entry == nullptr) {
+        if (s_used == SEMAPHORE_GUARD_RECURSION_STATS) {
+            return;  // Table full: mutexes seen first keep their entries
+        }
+        entry = &s_stats[s_used++];
+        *entry = RecursionStats{node.handle, 0, 0, 0};
+    }
+    entry->nestedSections++;
+    entry->reentries += node.reentries;
+    if (node.maxDepth > entry->maxDepth) {
+        entry->maxDepth = node.maxDepth;
+    }
+}
+
+size_t RecursiveOwnership::snapshot(RecursionStats* out, size_t maxEntries) {
+    RecursionStats copy[SEMAPHORE_GUARD_RECURSION_STATS];
+    size_t count;
+    {
+        CriticalSectionGuard guard(&s_mux);
+        count = s_used;
+        for (size_t i = 0; i < count; i++) {
+            copy[i] = s_stats[i];
+        }
+    }
+
+    // Selection sort, deepest first; the table is small
+    size_t copied = 0;
+    for (; copied < maxEntries && copied < count; copied++) {
+        size_t deepest = copied;
+        for (size_t i = copied + 1; i < count; i++) {
+            if (copy[i].maxDepth > copy[deepest].maxDepth) {
+                deepest = i;
+            }
+        }
+        const RecursionStats swap = copy[copied];
+        copy[copied] = copy[deepest];
+        copy[deepest] = swap;
+        out[copied] = copy[copied];
+    }
+    return copied;
+}
+
+void RecursiveOwnership::report() {
+    RecursionStats stats[SEMAPHORE_GUARD_RECURSION_STATS];
+    const size_t count = snapshot(stats, SEMAPHORE_GUARD_RECURSION_STATS);
+    REC_LOG_I("%u recursive mutex(es) re-entered:", (unsigned)count);
+    for (size_t i = 0; i < count; i++) {
+        REC_LOG_I("  %p: max depth %u, %lu nested sections, %lu fast re-entries",
+                  stats[i].handle, (unsigned)stats[i].maxDepth,
+                  (unsigned long)stats[i].nestedSections, (unsigned long)stats[i].reentries);
+    }
+}
+
+void RecursiveOwnership::reset() {
+    CriticalSectionGuard guard(&s_mux);
+    s_used = 0;
+}
@@ -0,0 +1,108 @@
+#ifndef _RECURSIVE_OWNERSHIP_H_
+#define _RECURSIVE_OWNERSHIP_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+
+// Thread-local storage slot holding the head of each task's list of owned
+// recursive mutexes. Lock ranks and HeldList use the last two slots and
+// pthread uses slot 0, so the default needs
+// CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS=4
+#ifndef SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX
+#define SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX (configNUM_THREAD_LOCAL_STORAGE_POINTERS - 3)
+#endif
+
+// Recursive mutexes whose maximum depth is kept
+#ifndef SEMAPHORE_GUARD_RECURSION_STATS
+#define SEMAPHORE_GUARD_RECURSION_STATS 16
+#endif
+
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+static_assert(SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX >= 1 &&
+              SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX < configNUM_THREAD_LOCAL_STORAGE_POINTERS,
+              "SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX must be a thread-local storage slot other than "
+              "pthread's slot 0; raise CONFIG_FREERTOS_THREAD_LOCAL_STORAGE_POINTERS");
+#endif
+
+// Embedded in the guard that took the mutex from the kernel; guards nested
+// inside it only count on it
+struct RecursiveOwnerNode {
+    RecursiveOwnerNode* next = nullptr;
+    SemaphoreHandle_t handle = nullptr;
+    uint16_t depth = 0;      // Guards currently holding handle through this node
+    uint16_t maxDepth = 0;   // Deepest nesting since the kernel take
+    uint32_t reentries = 0;  // Nested takes served without the kernel
+};
+
+// Recursion statistics of one mutex
+struct RecursionStats {
+    SemaphoreHandle_t handle;
+    uint16_t maxDepth;       // Deepest nesting seen
+    uint32_t nestedSections; // Outermost acquisitions that were re-entered
+    uint32_t reentries;      // Nested takes served without the kernel
+};
+
+// Recursive-ownership fast path for recursive mutex guards.
+//
+// With -DSEMAPHORE_GUARD_RECURSIVE_FAST_PATH the outermost guard on a
+// recursive mutex takes it from the kernel once and links a node into its
+// task's list. A guard on the same mutex nested inside it finds that node
+// and only bumps its depth: no xSemaphoreTakeRecursive(), no kernel
+// critical section. The kernel give happens when the depth drops back to
+// zero. Nested guards must not outlive the outermost one, which scoped
+// guards never do.
+//
+// When the depth is back at zero, sections that recursed publish their
+// maximum depth to a small per-mutex table, so the nesting cost is paid
+// once per outermost acquisition and not per level.
+//
+//     RecursionStats stats[8];
+//     size_t n = RecursiveOwnership::snapshot(stats, 8);
+//     RecursiveOwnership::report();
+class RecursiveOwnership {
+public:
+    // The calling task's node for handle, or nullptr if no guard of this
+    // task took it
+    [[nodiscard]] static RecursiveOwnerNode* find(SemaphoreHandle_t handle) {
+        RecursiveOwnerNode* node = static_cast<RecursiveOwnerNode*>(
+            pvTaskGetThreadLocalStoragePointer(nullptr, SEMAPHORE_GUARD_RECURSIVE_TLS_INDEX));
+        while (node != nullptr && node->handle != handle) {
+            node = node->next;
+        }
+        return node;
+    }
+
+    // Count a nested take on the node of an owned mutex
+    static void enter(RecursiveOwnerNode& node) {
+        node.depth++;
+        node.reentries++;
+        if (node.depth > node.maxDepth) {
+            node.maxDepth = node.depth;
+        }
+    }
+
+    // Link the node of a guard that has just taken handle from the kernel
+    static void push(RecursiveOwnerNode& node, SemaphoreHandle_t handle);
+
+    // Count a release; true when this was the last holder and the caller
+    // must give the mutex back to the kernel
+    static bool leave(RecursiveOwnerNode& node);
+
+    // Copy up to maxEntries per-mutex statistics, deepest first
+    static size_t snapshot(RecursionStats* out, size_t maxEntries);
+
+    // Log the per-mutex statistics
+    static void report();
+
+    // Clear the per-mutex statistics
+    static void reset();
+
+private:
+    static void unlink(RecursiveOwnerNode& node);
+    static void publish(const RecursiveOwnerNode& node);
+};
+
+#endif  // _RECURSIVE_OWNERSHIP_H_
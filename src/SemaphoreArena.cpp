@@ -0,0 +1,152 @@
+#include "SemaphoreArena.h"
+#include "CriticalSectionGuard.h"
+
+ArenaSemaphore::ArenaSemaphore(ArenaSemaphore&& other) noexcept
+    : m_handle(other.m_handle), m_arena(other.m_arena), m_slot(other.m_slot) {
+    other.m_handle = nullptr;
+    other.m_arena = nullptr;
+}
+
+ArenaSemaphore& ArenaSemaphore::operator=(ArenaSemaphore&& other) noexcept {
+    if (this != &other) {
+        reset();
+        m_handle = other.m_handle;
+        m_arena = other.m_arena;
+        m_slot = other.m_slot;
+        other.m_handle = nullptr;
+        other.m_arena = nullptr;
+    }
+    return *this;
+}
+
+ArenaSemaphore::~ArenaSemaphore() {
+    reset();
+}
+
+void ArenaSemaphore::reset() {
+    if (m_handle == nullptr) {
+        return;
+    }
+    // Static objects are only unregistered from the kernel; the storage
+    // stays in the arena and is handed out again
+    vSemaphoreDelete(m_handle);
+    m_arena->release(m_slot);
+    m_handle = nullptr;
+    m_arena = nullptr;
+}
+
+SemaphoreArenaBase::SemaphoreArenaBase(StaticSemaphore_t* storage, uint32_t* usedBits, size_t capacity)
+    : m_storage(storage), m_usedBits(usedBits), m_capacity(capacity),
+      m_inUse(0), m_highWater(0), m_failed(0) {
+    portMUX_INITIALIZE(&m_mux);
+}
+
+ArenaSemaphore SemaphoreArenaBase::createMutex() {
+    return create(Kind::Mutex, 0, 0);
+}
+
+ArenaSemaphore SemaphoreArenaBase::createRecursiveMutex() {
+    return create(Kind::RecursiveMutex, 0, 0);
+}
+
+ArenaSemaphore SemaphoreArenaBase::createBinary() {
+    return create(Kind::Binary, 0, 0);
+}
+
+ArenaSemaphore SemaphoreArenaBase::createCounting(UBaseType_t maxCount, UBaseType_t initialCount) {
+    if (maxCount == 0 || initialCount > maxCount) {
+        ARENA_LOG_E("Invalid counting semaphore limits (max %u, initial %u)",
+                    (unsigned)maxCount, (unsigned)initialCount);
+        return ArenaSemaphore();
+    }
+    return create(Kind::Counting, maxCount, initialCount);
+}
+
+ArenaSemaphore SemaphoreArenaBase::create(Kind kind, UBaseType_t maxCount, UBaseType_t initialCount) {
+    size_t slot;
+    if (!allocate(slot)) {
+        ARENA_LOG_E("Arena full (%u slots); increase its size",
+                    (unsigned)m_capacity);
+        return ArenaSemaphore();
+    }
+
+    StaticSemaphore_t* buffer = &m_storage[slot];
+    SemaphoreHandle_t handle = nullptr;
+    switch (kind) {
+        case Kind::Mutex:
+            handle = xSemaphoreCreateMutexStatic(buffer);
+            break;
+        case Kind::RecursiveMutex:
+            handle = xSemaphoreCreateRecursiveMutexStatic(buffer);
+            break;
+        case Kind::Binary:
+            handle = xSemaphoreCreateBinaryStatic(buffer);
+            break;
+        case Kind::Counting:
+            handle = xSemaphoreCreateCountingStatic(maxCount, initialCount, buffer);
+            break;
+    }
+
+    if (handle == nullptr) {
+        ARENA_LOG_E("Static semaphore creation failed in slot %u", (unsigned)slot);
+        release(slot);
+        return ArenaSemaphore();
+    }
+
+    ARENA_LOG_D("Created semaphore %p in slot %u", handle, (unsigned)slot);
+    return ArenaSemaphore(handle, this, slot);
+}
+
+bool SemaphoreArenaBase::allocate(size_t& slot) {
+    CriticalSectionGuard guard(&m_mux);
+    for (size_t word = 0; word * 32 < m_capacity; word++) {
+        const uint32_t used = m_usedBits[word];
+        if (used == UINT32_MAX) {
+            continue;
+        }
+        const size_t bit = __builtin_ctz(~used);
+        const size_t index = word * 32 + bit;
+        if (index >= m_capacity) {
+            break;
+        }
+        m_usedBits[word] = used | (1UL << bit);
+        if (++m_inUse > m_highWater) {
+            m_highWater = m_inUse;
+        }
+        slot = index;
+        return true;
+    }
+    m_failed++;
+    return false;
+}
+
+void SemaphoreArenaBase::release(size_t slot) {
+    CriticalSectionGuard guard(&m_mux);
+    m_usedBits[slot / 32] &= ~(1UL << (slot % 32));
+    m_inUse--;
+}
+
+size_t SemaphoreArenaBase::inUse() const {
+    CriticalSectionGuard guard(&m_mux);
+    return m_inUse;
+}
+
+SemaphoreArenaStats SemaphoreArenaBase::getStats() const {
+    SemaphoreArenaStats stats;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        stats.inUse = m_inUse;
+        stats.highWater = m_highWater;
+        stats.failed = m_failed;
+    }
+    stats.capacity = m_capacity;
+    stats.storageBytes = storageBytes();
+    return stats;
+}
+
+void SemaphoreArenaBase::logStats() const {
+    const SemaphoreArenaStats stats = getStats();
+    ARENA_LOG_I("%u/%u slots in use (high water %u, %u rejected), %u bytes reserved",
+                (unsigned)stats.inUse, (unsigned)stats.capacity, (unsigned)stats.highWater,
+                (unsigned)stats.failed, (unsigned)stats.storageBytes);
+}
@@ -0,0 +1,133 @@
+#ifndef _SEMAPHORE_ARENA_H_
+#define _SEMAPHORE_ARENA_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+
+class SemaphoreArenaBase;
+
+// Owning handle to a semaphore created in a SemaphoreArena. Deletes the
+// kernel object and returns its slot to the arena when destroyed.
+//
+// Converts implicitly to SemaphoreHandle_t, so it plugs straight into
+// SemaphoreGuard, RecursiveSemaphoreGuard and the SEMAPHORE_GUARD() macros:
+//
+//     ArenaSemaphore mutex = arena.createMutex();
+//     SEMAPHORE_GUARD(mutex);
+class ArenaSemaphore {
+public:
+    ArenaSemaphore() noexcept : m_handle(nullptr), m_arena(nullptr), m_slot(0) {}
+    ArenaSemaphore(ArenaSemaphore&& other) noexcept;
+    ArenaSemaphore& operator=(ArenaSemaphore&& other) noexcept;
+
+    // Destructor: Deletes the semaphore and frees its arena slot
+    ~ArenaSemaphore();
+
+    // Delete copy constructor and copy assignment to prevent double-delete
+    ArenaSemaphore(const ArenaSemaphore&) = delete;
+    ArenaSemaphore& operator=(const ArenaSemaphore&) = delete;
+
+    // Delete the semaphore now; the handle becomes invalid
+    void reset();
+
+    // Get the semaphore handle
+    [[nodiscard]] SemaphoreHandle_t get() const noexcept { return m_handle; }
+    operator SemaphoreHandle_t() const noexcept { return m_handle; }
+
+    // Check if creation succeeded
+    [[nodiscard]] bool isValid() const noexcept { return m_handle != nullptr; }
+
+private:
+    friend class SemaphoreArenaBase;
+    ArenaSemaphore(SemaphoreHandle_t handle, SemaphoreArenaBase* arena, size_t slot) noexcept
+        : m_handle(handle), m_arena(arena), m_slot(slot) {}
+
+    SemaphoreHandle_t m_handle;
+    SemaphoreArenaBase* m_arena;
+    size_t m_slot;
+};
+
+// Arena usage, for sizing the arena and spotting leaks
+struct SemaphoreArenaStats {
+    size_t capacity;      // Slots in the arena
+    size_t inUse;         // Slots currently holding a semaphore
+    size_t highWater;     // Most slots ever in use at once
+    size_t failed;        // Create calls rejected because the arena was full
+    size_t storageBytes;  // Static RAM reserved for kernel objects
+};
+
+// Slot allocator shared by every SemaphoreArena<N>; holds no storage itself
+class SemaphoreArenaBase {
+public:
+    // Delete copy and move; handles refer to this instance
+    SemaphoreArenaBase(const SemaphoreArenaBase&) = delete;
+    SemaphoreArenaBase& operator=(const SemaphoreArenaBase&) = delete;
+    SemaphoreArenaBase(SemaphoreArenaBase&&) = delete;
+    SemaphoreArenaBase& operator=(SemaphoreArenaBase&&) = delete;
+
+    // Create kernel objects in the arena with the ...Static() APIs. The
+    // returned handle is invalid if the arena is full
+    [[nodiscard]] ArenaSemaphore createMutex();
+    [[nodiscard]] ArenaSemaphore createRecursiveMutex();
+    [[nodiscard]] ArenaSemaphore createBinary();
+    [[nodiscard]] ArenaSemaphore createCounting(UBaseType_t maxCount, UBaseType_t initialCount);
+
+    // Usage snapshot
+    [[nodiscard]] SemaphoreArenaStats getStats() const;
+
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] size_t inUse() const;
+    [[nodiscard]] size_t storageBytes() const noexcept { return m_capacity * sizeof(StaticSemaphore_t); }
+
+    // Log the usage snapshot at info level
+    void logStats() const;
+
+protected:
+    SemaphoreArenaBase(StaticSemaphore_t* storage, uint32_t* usedBits, size_t capacity);
+    ~SemaphoreArenaBase() = default;
+
+private:
+    friend class ArenaSemaphore;
+
+    enum class Kind : uint8_t { Mutex, RecursiveMutex, Binary, Counting };
+
+    ArenaSemaphore create(Kind kind, UBaseType_t maxCount, UBaseType_t initialCount);
+    bool allocate(size_t& slot);
+    void release(size_t slot);
+
+    StaticSemaphore_t* m_storage;
+    uint32_t* m_usedBits;  // One bit per slot, guarded by m_mux
+    size_t m_capacity;
+    size_t m_inUse;
+    size_t m_highWater;
+    size_t m_failed;
+    mutable portMUX_TYPE m_mux;
+};
+
+// Compile-time-sized pool of StaticSemaphore_t storage. Semaphores created
+// here never touch the heap, so long-running devices do not fragment it and
+// memory use is fixed at link time. Creation is also cheaper than
+// xSemaphoreCreateMutex(), which has to go through the allocator.
+//
+// Declare the arena at namespace scope (or as a static) so it outlives every
+// handle created from it:
+//
+//     static SemaphoreArena<8> gArena;
+//     ArenaSemaphore xBusMutex = gArena.createMutex();
+template <size_t N>
+class SemaphoreArena : public SemaphoreArenaBase {
+    static_assert(N > 0, "SemaphoreArena needs at least one slot");
+
+public:
+    SemaphoreArena() : SemaphoreArenaBase(m_slots, m_bits, N) {}
+
+private:
+    StaticSemaphore_t m_slots[N];
+    uint32_t m_bits[(N + 31) / 32] = {};
+};
+
+#endif  // _SEMAPHORE_ARENA_H_
@@ -0,0 +1,18 @@
+#ifndef _SEMAPHORE_GUARD_CYCLES_H_
+#define _SEMAPHORE_GUARD_CYCLES_H_
+#include <stdint.h>
+#include <esp_idf_version.h>
+#include <esp_cpu.h>
+
+// CPU cycle counter used for short duration measurements (critical
+// sections, sampled wait/hold times). Wraps every few seconds at 240 MHz,
+// so only differences between nearby readings are meaningful.
+static inline uint32_t semgCycleCount() {
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 0, 0)
+    return static_cast<uint32_t>(esp_cpu_get_cycle_count());
+#else
+    return esp_cpu_get_ccount();
+#endif
+}
+
+#endif  // _SEMAPHORE_GUARD_CYCLES_H_
@@ -4,6 +4,21 @@
 // Log tags for different components
 #define SEMG_LOG_TAG "SemaphoreGuard"
 #define RSEMG_LOG_TAG "RecursiveSemaphoreGuard"
+#define ISEMG_LOG_TAG "IsrSemaphoreGuard"
+#define CSG_LOG_TAG "CriticalSectionGuard"
+#define ALD_LOG_TAG "AsyncLockDispatcher"
+#define ARENA_LOG_TAG "SemaphoreArena"
+#define LAZY_LOG_TAG "LazySemaphore"
+#define CV_LOG_TAG "ConditionVariable"
+#define TLK_LOG_TAG "TicketLock"
+#define MCS_LOG_TAG "McsLock"
+#define PCG_LOG_TAG "PriorityCeilingGuard"
+#define RANK_LOG_TAG "LockRank"
+#define HLT_LOG_TAG "HeldLockTable"
+#define DLD_LOG_TAG "DeadlockDetector"
+#define SAMP_LOG_TAG "ContentionProfiler"
+#define HELD_LOG_TAG "HeldList"
+#define REC_LOG_TAG "RecursiveOwnership"
 
 // Define log levels based on debug flag
 #ifdef SEMAPHORE_GUARD_DEBUG
@@ -38,6 +53,111 @@
     #define RSEMG_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, RSEMG_LOG_TAG, __VA_ARGS__)
     #define RSEMG_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, RSEMG_LOG_TAG, __VA_ARGS__)
     #define RSEMG_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, RSEMG_LOG_TAG, __VA_ARGS__)
+    
+    // IsrSemaphoreGuard logging macros (task context only)
+    #define ISEMG_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, ISEMG_LOG_TAG, __VA_ARGS__)
+    #define ISEMG_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, ISEMG_LOG_TAG, __VA_ARGS__)
+    #define ISEMG_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, ISEMG_LOG_TAG, __VA_ARGS__)
+    #define ISEMG_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, ISEMG_LOG_TAG, __VA_ARGS__)
+    #define ISEMG_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, ISEMG_LOG_TAG, __VA_ARGS__)
+    
+    // CriticalSectionGuard logging macros (never called with interrupts disabled)
+    #define CSG_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, CSG_LOG_TAG, __VA_ARGS__)
+    #define CSG_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, CSG_LOG_TAG, __VA_ARGS__)
+    #define CSG_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, CSG_LOG_TAG, __VA_ARGS__)
+    #define CSG_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, CSG_LOG_TAG, __VA_ARGS__)
+    #define CSG_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, CSG_LOG_TAG, __VA_ARGS__)
+    
+    // AsyncLockDispatcher logging macros
+    #define ALD_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, ALD_LOG_TAG, __VA_ARGS__)
+    #define ALD_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, ALD_LOG_TAG, __VA_ARGS__)
+    #define ALD_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, ALD_LOG_TAG, __VA_ARGS__)
+    #define ALD_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, ALD_LOG_TAG, __VA_ARGS__)
+    #define ALD_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, ALD_LOG_TAG, __VA_ARGS__)
+    
+    // SemaphoreArena logging macros
+    #define ARENA_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, ARENA_LOG_TAG, __VA_ARGS__)
+    #define ARENA_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, ARENA_LOG_TAG, __VA_ARGS__)
+    #define ARENA_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, ARENA_LOG_TAG, __VA_ARGS__)
+    #define ARENA_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, ARENA_LOG_TAG, __VA_ARGS__)
+    #define ARENA_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, ARENA_LOG_TAG, __VA_ARGS__)
+    
+    // LazySemaphore logging macros
+    #define LAZY_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, LAZY_LOG_TAG, __VA_ARGS__)
+    #define LAZY_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, LAZY_LOG_TAG, __VA_ARGS__)
+    #define LAZY_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, LAZY_LOG_TAG, __VA_ARGS__)
+    #define LAZY_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, LAZY_LOG_TAG, __VA_ARGS__)
+    #define LAZY_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, LAZY_LOG_TAG, __VA_ARGS__)
+    
+    // ConditionVariable logging macros
+    #define CV_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, CV_LOG_TAG, __VA_ARGS__)
+    #define CV_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, CV_LOG_TAG, __VA_ARGS__)
+    #define CV_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, CV_LOG_TAG, __VA_ARGS__)
+    #define CV_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, CV_LOG_TAG, __VA_ARGS__)
+    #define CV_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, CV_LOG_TAG, __VA_ARGS__)
+    
+    // TicketLock logging macros
+    #define TLK_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, TLK_LOG_TAG, __VA_ARGS__)
+    #define TLK_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, TLK_LOG_TAG, __VA_ARGS__)
+    #define TLK_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, TLK_LOG_TAG, __VA_ARGS__)
+    #define TLK_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, TLK_LOG_TAG, __VA_ARGS__)
+    #define TLK_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, TLK_LOG_TAG, __VA_ARGS__)
+    
+    // McsLock logging macros
+    #define MCS_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, MCS_LOG_TAG, __VA_ARGS__)
+    #define MCS_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, MCS_LOG_TAG, __VA_ARGS__)
+    #define MCS_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, MCS_LOG_TAG, __VA_ARGS__)
+    #define MCS_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, MCS_LOG_TAG, __VA_ARGS__)
+    #define MCS_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, MCS_LOG_TAG, __VA_ARGS__)
+    
+    // PriorityCeilingGuard logging macros
+    #define PCG_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, PCG_LOG_TAG, __VA_ARGS__)
+    #define PCG_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, PCG_LOG_TAG, __VA_ARGS__)
+    #define PCG_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, PCG_LOG_TAG, __VA_ARGS__)
+    #define PCG_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, PCG_LOG_TAG, __VA_ARGS__)
+    #define PCG_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, PCG_LOG_TAG, __VA_ARGS__)
+    
+    // LockRank logging macros
+    #define RANK_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, RANK_LOG_TAG, __VA_ARGS__)
+    #define RANK_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, RANK_LOG_TAG, __VA_ARGS__)
+    #define RANK_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, RANK_LOG_TAG, __VA_ARGS__)
+    #define RANK_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, RANK_LOG_TAG, __VA_ARGS__)
+    #define RANK_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, RANK_LOG_TAG, __VA_ARGS__)
+    
+    // HeldLockTable logging macros
+    #define HLT_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, HLT_LOG_TAG, __VA_ARGS__)
+    #define HLT_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, HLT_LOG_TAG, __VA_ARGS__)
+    #define HLT_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, HLT_LOG_TAG, __VA_ARGS__)
+    #define HLT_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, HLT_LOG_TAG, __VA_ARGS__)
+    #define HLT_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, HLT_LOG_TAG, __VA_ARGS__)
+    
+    // DeadlockDetector logging macros
+    #define DLD_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, DLD_LOG_TAG, __VA_ARGS__)
+    #define DLD_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, DLD_LOG_TAG, __VA_ARGS__)
+    #define DLD_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, DLD_LOG_TAG, __VA_ARGS__)
+    #define DLD_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, DLD_LOG_TAG, __VA_ARGS__)
+    #define DLD_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, DLD_LOG_TAG, __VA_ARGS__)
+    
+    // ContentionProfiler logging macros
+    #define SAMP_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, SAMP_LOG_TAG, __VA_ARGS__)
+    #define SAMP_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, SAMP_LOG_TAG, __VA_ARGS__)
+    #define SAMP_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, SAMP_LOG_TAG, __VA_ARGS__)
+    #define SAMP_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, SAMP_LOG_TAG, __VA_ARGS__)
+    #define SAMP_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, SAMP_LOG_TAG, __VA_ARGS__)
+    
+    // HeldList logging macros
+    #define HELD_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, HELD_LOG_TAG, __VA_ARGS__)
+    #define HELD_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, HELD_LOG_TAG, __VA_ARGS__)
+    #define HELD_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, HELD_LOG_TAG, __VA_ARGS__)
+    #define HELD_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, HELD_LOG_TAG, __VA_ARGS__)
+    #define HELD_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, HELD_LOG_TAG, __VA_ARGS__)
+    
+    // RecursiveOwnership logging macros
+    #define REC_LOG_E(...) LOG_WRITE(SEMG_LOG_LEVEL_E, REC_LOG_TAG, __VA_ARGS__)
+    #define REC_LOG_W(...) LOG_WRITE(SEMG_LOG_LEVEL_W, REC_LOG_TAG, __VA_ARGS__)
+    #define REC_LOG_I(...) LOG_WRITE(SEMG_LOG_LEVEL_I, REC_LOG_TAG, __VA_ARGS__)
+    #define REC_LOG_D(...) LOG_WRITE(SEMG_LOG_LEVEL_D, REC_LOG_TAG, __VA_ARGS__)
+    #define REC_LOG_V(...) LOG_WRITE(SEMG_LOG_LEVEL_V, REC_LOG_TAG, __VA_ARGS__)
 #else
     // ESP-IDF logging with compile-time suppression
     #include <esp_log.h>
@@ -65,6 +185,186 @@
         #define RSEMG_LOG_D(...) ((void)0)
         #define RSEMG_LOG_V(...) ((void)0)
     #endif
+    
+    // IsrSemaphoreGuard logging macros (task context only)
+    #define ISEMG_LOG_E(...) ESP_LOGE(ISEMG_LOG_TAG, __VA_ARGS__)
+    #define ISEMG_LOG_W(...) ESP_LOGW(ISEMG_LOG_TAG, __VA_ARGS__)
+    #define ISEMG_LOG_I(...) ESP_LOGI(ISEMG_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define ISEMG_LOG_D(...) ESP_LOGD(ISEMG_LOG_TAG, __VA_ARGS__)
+        #define ISEMG_LOG_V(...) ESP_LOGV(ISEMG_LOG_TAG, __VA_ARGS__)
+    #else
+        #define ISEMG_LOG_D(...) ((void)0)
+        #define ISEMG_LOG_V(...) ((void)0)
+    #endif
+    
+    // CriticalSectionGuard logging macros (never called with interrupts disabled)
+    #define CSG_LOG_E(...) ESP_LOGE(CSG_LOG_TAG, __VA_ARGS__)
+    #define CSG_LOG_W(...) ESP_LOGW(CSG_LOG_TAG, __VA_ARGS__)
+    #define CSG_LOG_I(...) ESP_LOGI(CSG_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define CSG_LOG_D(...) ESP_LOGD(CSG_LOG_TAG, __VA_ARGS__)
+        #define CSG_LOG_V(...) ESP_LOGV(CSG_LOG_TAG, __VA_ARGS__)
+    #else
+        #define CSG_LOG_D(...) ((void)0)
+        #define CSG_LOG_V(...) ((void)0)
+    #endif
+    
+    // AsyncLockDispatcher logging macros
+    #define ALD_LOG_E(...) ESP_LOGE(ALD_LOG_TAG, __VA_ARGS__)
+    #define ALD_LOG_W(...) ESP_LOGW(ALD_LOG_TAG, __VA_ARGS__)
+    #define ALD_LOG_I(...) ESP_LOGI(ALD_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define ALD_LOG_D(...) ESP_LOGD(ALD_LOG_TAG, __VA_ARGS__)
+        #define ALD_LOG_V(...) ESP_LOGV(ALD_LOG_TAG, __VA_ARGS__)
+    #else
+        #define ALD_LOG_D(...) ((void)0)
+        #define ALD_LOG_V(...) ((void)0)
+    #endif
+    
+    // SemaphoreArena logging macros
+    #define ARENA_LOG_E(...) ESP_LOGE(ARENA_LOG_TAG, __VA_ARGS__)
+    #define ARENA_LOG_W(...) ESP_LOGW(ARENA_LOG_TAG, __VA_ARGS__)
+    #define ARENA_LOG_I(...) ESP_LOGI(ARENA_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define ARENA_LOG_D(...) ESP_LOGD(ARENA_LOG_TAG, __VA_ARGS__)
+        #define ARENA_LOG_V(...) ESP_LOGV(ARENA_LOG_TAG, __VA_ARGS__)
+    #else
+        #define ARENA_LOG_D(...) ((void)0)
+        #define ARENA_LOG_V(...) ((void)0)
+    #endif
+    
+    // LazySemaphore logging macros
+    #define LAZY_LOG_E(...) ESP_LOGE(LAZY_LOG_TAG, __VA_ARGS__)
+    #define LAZY_LOG_W(...) ESP_LOGW(LAZY_LOG_TAG, __VA_ARGS__)
+    #define LAZY_LOG_I(...) ESP_LOGI(LAZY_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define LAZY_LOG_D(...) ESP_LOGD(LAZY_LOG_TAG, __VA_ARGS__)
+        #define LAZY_LOG_V(...) ESP_LOGV(LAZY_LOG_TAG, __VA_ARGS__)
+    #else
+        #define LAZY_LOG_D(...) ((void)0)
+        #define LAZY_LOG_V(...) ((void)0)
+    #endif
+    
+    // ConditionVariable logging macros
+    #define CV_LOG_E(...) ESP_LOGE(CV_LOG_TAG, __VA_ARGS__)
+    #define CV_LOG_W(...) ESP_LOGW(CV_LOG_TAG, __VA_ARGS__)
+    #define CV_LOG_I(...) ESP_LOGI(CV_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define CV_LOG_D(...) ESP_LOGD(CV_LOG_TAG, __VA_ARGS__)
+        #define CV_LOG_V(...) ESP_LOGV(CV_LOG_TAG, __VA_ARGS__)
+    #else
+        #define CV_LOG_D(...) ((void)0)
+        #define CV_LOG_V(...) ((void)0)
+    #endif
+    
+    // TicketLock logging macros
+    #define TLK_LOG_E(...) ESP_LOGE(TLK_LOG_TAG, __VA_ARGS__)
+    #define TLK_LOG_W(...) ESP_LOGW(TLK_LOG_TAG, __VA_ARGS__)
+    #define TLK_LOG_I(...) ESP_LOGI(TLK_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define TLK_LOG_D(...) ESP_LOGD(TLK_LOG_TAG, __VA_ARGS__)
+        #define TLK_LOG_V(...) ESP_LOGV(TLK_LOG_TAG, __VA_ARGS__)
+    #else
+        #define TLK_LOG_D(...) ((void)0)
+        #define TLK_LOG_V(...) ((void)0)
+    #endif
+    
+    // McsLock logging macros
+    #define MCS_LOG_E(...) ESP_LOGE(MCS_LOG_TAG, __VA_ARGS__)
+    #define MCS_LOG_W(...) ESP_LOGW(MCS_LOG_TAG, __VA_ARGS__)
+    #define MCS_LOG_I(...) ESP_LOGI(MCS_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define MCS_LOG_D(...) ESP_LOGD(MCS_LOG_TAG, __VA_ARGS__)
+        #define MCS_LOG_V(...) ESP_LOGV(MCS_LOG_TAG, __VA_ARGS__)
+    #else
+        #define MCS_LOG_D(...) ((void)0)
+        #define MCS_LOG_V(...) ((void)0)
+    #endif
+    
+    // PriorityCeilingGuard logging macros
+    #define PCG_LOG_E(...) ESP_LOGE(PCG_LOG_TAG, __VA_ARGS__)
+    #define PCG_LOG_W(...) ESP_LOGW(PCG_LOG_TAG, __VA_ARGS__)
+    #define PCG_LOG_I(...) ESP_LOGI(PCG_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define PCG_LOG_D(...) ESP_LOGD(PCG_LOG_TAG, __VA_ARGS__)
+        #define PCG_LOG_V(...) ESP_LOGV(PCG_LOG_TAG, __VA_ARGS__)
+    #else
+        #define PCG_LOG_D(...) ((void)0)
+        #define PCG_LOG_V(...) ((void)0)
+    #endif
+    
+    // LockRank logging macros
+    #define RANK_LOG_E(...) ESP_LOGE(RANK_LOG_TAG, __VA_ARGS__)
+    #define RANK_LOG_W(...) ESP_LOGW(RANK_LOG_TAG, __VA_ARGS__)
+    #define RANK_LOG_I(...) ESP_LOGI(RANK_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define RANK_LOG_D(...) ESP_LOGD(RANK_LOG_TAG, __VA_ARGS__)
+        #define RANK_LOG_V(...) ESP_LOGV(RANK_LOG_TAG, __VA_ARGS__)
+    #else
+        #define RANK_LOG_D(...) ((void)0)
+        #define RANK_LOG_V(...) ((void)0)
+    #endif
+    
+    // HeldLockTable logging macros
+    #define HLT_LOG_E(...) ESP_LOGE(HLT_LOG_TAG, __VA_ARGS__)
+    #define HLT_LOG_W(...) ESP_LOGW(HLT_LOG_TAG, __VA_ARGS__)
+    #define HLT_LOG_I(...) ESP_LOGI(HLT_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define HLT_LOG_D(...) ESP_LOGD(HLT_LOG_TAG, __VA_ARGS__)
+        #define HLT_LOG_V(...) ESP_LOGV(HLT_LOG_TAG, __VA_ARGS__)
+    #else
+        #define HLT_LOG_D(...) ((void)0)
+        #define HLT_LOG_V(...) ((void)0)
+    #endif
+    
+    // DeadlockDetector logging macros
+    #define DLD_LOG_E(...) ESP_LOGE(DLD_LOG_TAG, __VA_ARGS__)
+    #define DLD_LOG_W(...) ESP_LOGW(DLD_LOG_TAG, __VA_ARGS__)
+    #define DLD_LOG_I(...) ESP_LOGI(DLD_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define DLD_LOG_D(...) ESP_LOGD(DLD_LOG_TAG, __VA_ARGS__)
+        #define DLD_LOG_V(...) ESP_LOGV(DLD_LOG_TAG, __VA_ARGS__)
+    #else
+        #define DLD_LOG_D(...) ((void)0)
+        #define DLD_LOG_V(...) ((void)0)
+    #endif
+    
+    // ContentionProfiler logging macros
+    #define SAMP_LOG_E(...) ESP_LOGE(SAMP_LOG_TAG, __VA_ARGS__)
+    #define SAMP_LOG_W(...) ESP_LOGW(SAMP_LOG_TAG, __VA_ARGS__)
+    #define SAMP_LOG_I(...) ESP_LOGI(SAMP_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define SAMP_LOG_D(...) ESP_LOGD(SAMP_LOG_TAG, __VA_ARGS__)
+        #define SAMP_LOG_V(...) ESP_LOGV(SAMP_LOG_TAG, __VA_ARGS__)
+    #else
+        #define SAMP_LOG_D(...) ((void)0)
+        #define SAMP_LOG_V(...) ((void)0)
+    #endif
+    
+    // HeldList logging macros
+    #define HELD_LOG_E(...) ESP_LOGE(HELD_LOG_TAG, __VA_ARGS__)
+    #define HELD_LOG_W(...) ESP_LOGW(HELD_LOG_TAG, __VA_ARGS__)
+    #define HELD_LOG_I(...) ESP_LOGI(HELD_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define HELD_LOG_D(...) ESP_LOGD(HELD_LOG_TAG, __VA_ARGS__)
+        #define HELD_LOG_V(...) ESP_LOGV(HELD_LOG_TAG, __VA_ARGS__)
+    #else
+        #define HELD_LOG_D(...) ((void)0)
+        #define HELD_LOG_V(...) ((void)0)
+    #endif
+    
+    // RecursiveOwnership logging macros
+    #define REC_LOG_E(...) ESP_LOGE(REC_LOG_TAG, __VA_ARGS__)
+    #define REC_LOG_W(...) ESP_LOGW(REC_LOG_TAG, __VA_ARGS__)
+    #define REC_LOG_I(...) ESP_LOGI(REC_LOG_TAG, __VA_ARGS__)
+    #ifdef SEMAPHORE_GUARD_DEBUG
+        #define REC_LOG_D(...) ESP_LOGD(REC_LOG_TAG, __VA_ARGS__)
+        #define REC_LOG_V(...) ESP_LOGV(REC_LOG_TAG, __VA_ARGS__)
+    #else
+        #define REC_LOG_D(...) ((void)0)
+        #define REC_LOG_V(...) ((void)0)
+    #endif
 #endif
 
 // Legacy debug macro for backward compatibility
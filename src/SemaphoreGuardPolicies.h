@@ -0,0 +1,201 @@
+#ifndef _SEMAPHORE_GUARD_POLICIES_H_
+#define _SEMAPHORE_GUARD_POLICIES_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/task.h>
+#include <type_traits>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "GuardSite.h"
+#include "SemaphoreWaiters.h"
+#ifdef SEMAPHORE_GUARD_HELD_LOCK_TABLE
+#include "HeldLockTable.h"
+#endif
+#ifdef SEMAPHORE_GUARD_DEADLOCK_DETECTION
+#include "DeadlockDetector.h"
+#endif
+#ifdef SEMAPHORE_GUARD_SAMPLING_PROFILER
+#include "ContentionProfiler.h"
+#endif
+
+// Policies plugged into BasicSemaphoreGuard. Each one is a small struct of
+// static or inline members; empty policies are inherited as empty bases, so
+// an unused policy adds neither bytes nor instructions to the guard.
+
+// ---------------------------------------------------------------------------
+// Acquire policies: how the kernel object is taken and given back. Both
+// count blocking takes in SemaphoreWaiters; with
+// -DSEMAPHORE_GUARD_DEADLOCK_DETECTION they also register them with
+// DeadlockDetector
+
+// Binary and counting semaphores and plain mutexes
+struct SemaphoreAcquire {
+    static bool take(SemaphoreHandle_t handle, TickType_t timeout) {
+#ifdef SEMAPHORE_GUARD_DEADLOCK_DETECTION
+        return DeadlockDetector::take(handle, timeout, false);
+#else
+        return SemaphoreWaiters::take(handle, timeout, false);
+#endif
+    }
+    static void give(SemaphoreHandle_t handle) {
+        xSemaphoreGive(handle);
+    }
+};
+
+// Recursive mutexes
+struct RecursiveMutexAcquire {
+    static constexpr bool recursive = true;
+    static bool take(SemaphoreHandle_t handle, TickType_t timeout) {
+#ifdef SEMAPHORE_GUARD_DEADLOCK_DETECTION
+        return DeadlockDetector::take(handle, timeout, true);
+#else
+        return SemaphoreWaiters::take(handle, timeout, true);
+#endif
+    }
+    static void give(SemaphoreHandle_t handle) {
+        xSemaphoreGiveRecursive(handle);
+    }
+};
+
+// Maps any valid type to void for member detection; std::void_t is C++17
+template <typename...>
+struct MakeVoid {
+    typedef void type;
+};
+
+// Whether an acquire policy may take a handle its task already holds;
+// policies say so with a static constexpr bool recursive = true member
+template <typename Acquire, typename = void>
+struct AcquireTakesRecursively : std::false_type {};
+
+template <typename Acquire>
+struct AcquireTakesRecursively<Acquire, typename MakeVoid<decltype(Acquire::recursive)>::type>
+    : std::integral_constant<bool, Acquire::recursive> {};
+
+// ---------------------------------------------------------------------------
+// Timing policies: measure how long the lock is held
+
+struct NoTiming {
+    void markAcquired() {}
+    TickType_t heldTicks() const { return 0; }
+};
+
+struct TickTiming {
+    void markAcquired() { m_acquireTime = xTaskGetTickCount(); }
+    TickType_t heldTicks() const { return xTaskGetTickCount() - m_acquireTime; }
+
+    TickType_t m_acquireTime = 0;
+};
+
+// Hold times are only reported by the debug log
+#ifdef SEMAPHORE_GUARD_DEBUG
+typedef TickTiming DefaultTimingPolicy;
+#else
+typedef NoTiming DefaultTimingPolicy;
+#endif
+
+// ---------------------------------------------------------------------------
+// Stats policies: hooks around every acquisition and release
+
+struct NoStats {
+    void onAcquireStart(SemaphoreHandle_t) {}
+    void onAcquireEnd(SemaphoreHandle_t, bool, const GuardSite&) {}
+    void onRelease(SemaphoreHandle_t) {}
+};
+
+// Runs two stats policies; releases are reported in reverse order
+template <typename First, typename Second>
+struct CombinedStats : First, Second {
+    void onAcquireStart(SemaphoreHandle_t handle) {
+        First::onAcquireStart(handle);
+        Second::onAcquireStart(handle);
+    }
+    void onAcquireEnd(SemaphoreHandle_t handle, bool taken, const GuardSite& site) {
+        First::onAcquireEnd(handle, taken, site);
+        Second::onAcquireEnd(handle, taken, site);
+    }
+    void onRelease(SemaphoreHandle_t handle) {
+        Second::onRelease(handle);
+        First::onRelease(handle);
+    }
+};
+
+// Default guards record themselves in the retained held-lock table and/or
+// feed the sampling contention profiler when built with the matching flag
+#if defined(SEMAPHORE_GUARD_HELD_LOCK_TABLE) && defined(SEMAPHORE_GUARD_SAMPLING_PROFILER)
+typedef CombinedStats<HeldLockRecorder, SamplingStats> DefaultStatsPolicy;
+#elif defined(SEMAPHORE_GUARD_HELD_LOCK_TABLE)
+typedef HeldLockRecorder DefaultStatsPolicy;
+#elif defined(SEMAPHORE_GUARD_SAMPLING_PROFILER)
+typedef SamplingStats DefaultStatsPolicy;
+#else
+typedef NoStats DefaultStatsPolicy;
+#endif
+
+// ---------------------------------------------------------------------------
+// Log policies: the messages a guard emits
+//
+// ESP-IDF log macros need literal format strings, so each policy is stamped
+// out by this macro with its log prefix, guard name and object noun pasted
+// into the literals. Define your own with e.g.
+//     SEMAPHORE_GUARD_LOG_POLICY(BusLog, SEMG, "BusGuard", "bus mutex")
+
+#define SEMAPHORE_GUARD_LOG_POLICY(Name, PREFIX, GUARD, OBJECT)                                  \
+    struct Name {                                                                                \
+        static void nullHandle() { PREFIX##_LOG_E("Null " OBJECT " handle provided"); }          \
+        static void inIsr() { PREFIX##_LOG_E("Cannot use " GUARD " in ISR context"); }           \
+        static void nullHandle([[maybe_unused]] const char* file, [[maybe_unused]] int line) {   \
+            PREFIX##_LOG_E("Null " OBJECT " handle provided at %s:%d", file, line);              \
+        }                                                                                        \
+        static void inIsr([[maybe_unused]] const char* file, [[maybe_unused]] int line) {        \
+            PREFIX##_LOG_E("Cannot use " GUARD " in ISR context at %s:%d", file, line);          \
+        }                                                                                        \
+        static void attempt([[maybe_unused]] const char* file, [[maybe_unused]] int line) {      \
+            PREFIX##_LOG_D("Attempting to acquire " OBJECT " at %s:%d", file, line);             \
+        }                                                                                        \
+        static void attemptTimeout([[maybe_unused]] TickType_t timeout,                          \
+                                   [[maybe_unused]] const char* file, [[maybe_unused]] int line) { \
+            PREFIX##_LOG_D("Attempting to acquire " OBJECT " with timeout %lu at %s:%d",         \
+                           (unsigned long)timeout, file, line);                                  \
+        }                                                                                        \
+        static void attemptDeadline([[maybe_unused]] TickType_t remaining,                       \
+                                    [[maybe_unused]] const char* file, [[maybe_unused]] int line) { \
+            PREFIX##_LOG_D("Attempting to acquire " OBJECT " with %lu ticks of budget left at %s:%d", \
+                           (unsigned long)remaining, file, line);                                \
+        }                                                                                        \
+        static void acquired([[maybe_unused]] const char* file, [[maybe_unused]] int line) {     \
+            PREFIX##_LOG_D("Acquired " OBJECT " at %s:%d", file, line);                          \
+        }                                                                                        \
+        static void timedOut([[maybe_unused]] const char* file, [[maybe_unused]] int line) {     \
+            PREFIX##_LOG_W("Failed to acquire " OBJECT " within timeout at %s:%d", file, line);  \
+        }                                                                                        \
+        static void deadlineExpired([[maybe_unused]] const char* file, [[maybe_unused]] int line) { \
+            PREFIX##_LOG_W("Deadline expired before acquiring " OBJECT " at %s:%d", file, line); \
+        }                                                                                        \
+        static void releasing([[maybe_unused]] const char* file, [[maybe_unused]] int line,      \
+                              [[maybe_unused]] TickType_t held) {                                \
+            PREFIX##_LOG_D("Releasing " OBJECT " at %s:%d (held for %lu ticks)",                 \
+                           file, line, (unsigned long)held);                                     \
+        }                                                                                        \
+    }
+
+SEMAPHORE_GUARD_LOG_POLICY(SemaphoreLog, SEMG, "SemaphoreGuard", "semaphore");
+SEMAPHORE_GUARD_LOG_POLICY(RecursiveMutexLog, RSEMG, "RecursiveSemaphoreGuard", "recursive mutex");
+
+// Silent guard, e.g. for hot paths that check hasLock() themselves
+struct NoLog {
+    static void nullHandle() {}
+    static void inIsr() {}
+    static void nullHandle(const char*, int) {}
+    static void inIsr(const char*, int) {}
+    static void attempt(const char*, int) {}
+    static void attemptTimeout(TickType_t, const char*, int) {}
+    static void attemptDeadline(TickType_t, const char*, int) {}
+    static void acquired(const char*, int) {}
+    static void timedOut(const char*, int) {}
+    static void deadlineExpired(const char*, int) {}
+    static void releasing(const char*, int, TickType_t) {}
+};
+
+#endif  // _SEMAPHORE_GUARD_POLICIES_H_
@@ -0,0 +1,111 @@
+#ifndef _SEMAPHORE_HANDLES_H_
+#define _SEMAPHORE_HANDLES_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <type_traits>
+
+#include "SemaphoreGuardPolicies.h"
+
+// Strongly typed, non-owning semaphore handles.
+//
+// A raw SemaphoreHandle_t does not say whether it is a recursive mutex, so
+// nothing stops it from reaching the wrong guard, and the mismatch only
+// shows up as a hang. Typed handles carry the kind in the type:
+// SemaphoreGuardFor<H> and the SEMAPHORE_GUARD() macro pick
+// xSemaphoreTake() or xSemaphoreTakeRecursive() at compile time, and
+// handing a typed handle to the wrong guard fails to compile.
+//
+//     static RecursiveMutexHandle xLogMutex = createRecursiveMutex();
+//     SEMAPHORE_GUARD(xLogMutex);           // RecursiveSemaphoreGuard
+//     SemaphoreGuard guard(xLogMutex);      // Compile error
+//
+// Typed handles do not convert implicitly to SemaphoreHandle_t; use get()
+// for FreeRTOS calls.
+
+// Kind tags: the acquire and log policies a guard must use for each kind
+struct MutexKind {
+    typedef SemaphoreAcquire Acquire;
+    typedef SemaphoreLog Log;
+};
+
+struct RecursiveMutexKind {
+    typedef RecursiveMutexAcquire Acquire;
+    typedef RecursiveMutexLog Log;
+};
+
+struct BinarySemaphoreKind {
+    typedef SemaphoreAcquire Acquire;
+    typedef SemaphoreLog Log;
+};
+
+struct CountingSemaphoreKind {
+    typedef SemaphoreAcquire Acquire;
+    typedef SemaphoreLog Log;
+};
+
+template <typename Kind>
+class TypedSemaphoreHandle {
+public:
+    typedef Kind KindType;
+
+    constexpr TypedSemaphoreHandle() noexcept : m_handle(nullptr) {}
+
+    // Wrap a handle created elsewhere; the caller vouches for its kind
+    constexpr explicit TypedSemaphoreHandle(SemaphoreHandle_t handle) noexcept : m_handle(handle) {}
+
+    // Get the raw handle for FreeRTOS calls
+    [[nodiscard]] SemaphoreHandle_t get() const noexcept { return m_handle; }
+
+    // Check if this handle is valid (non-null)
+    [[nodiscard]] bool isValid() const noexcept { return m_handle != nullptr; }
+
+    // Delete the kernel object; the handle becomes invalid
+    void destroy() {
+        if (m_handle != nullptr) {
+            vSemaphoreDelete(m_handle);
+            m_handle = nullptr;
+        }
+    }
+
+private:
+    SemaphoreHandle_t m_handle;
+};
+
+typedef TypedSemaphoreHandle<MutexKind> MutexHandle;
+typedef TypedSemaphoreHandle<RecursiveMutexKind> RecursiveMutexHandle;
+typedef TypedSemaphoreHandle<BinarySemaphoreKind> BinarySemaphoreHandle;
+typedef TypedSemaphoreHandle<CountingSemaphoreKind> CountingSemaphoreHandle;
+
+// Factories; the result is invalid if the kernel object could not be created
+inline MutexHandle createMutex() {
+    return MutexHandle(xSemaphoreCreateMutex());
+}
+
+inline RecursiveMutexHandle createRecursiveMutex() {
+    return RecursiveMutexHandle(xSemaphoreCreateRecursiveMutex());
+}
+
+inline BinarySemaphoreHandle createBinarySemaphore() {
+    return BinarySemaphoreHandle(xSemaphoreCreateBinary());
+}
+
+inline CountingSemaphoreHandle createCountingSemaphore(UBaseType_t maxCount, UBaseType_t initialCount) {
+    return CountingSemaphoreHandle(xSemaphoreCreateCounting(maxCount, initialCount));
+}
+
+// Maps a handle type to its guard policies. Raw handles and anything that
+// converts to SemaphoreHandle_t (LazySemaphore, ArenaSemaphore) keep the
+// plain SemaphoreGuard behaviour
+template <typename Handle>
+struct SemaphoreHandleTraits {
+    typedef SemaphoreAcquire Acquire;
+    typedef SemaphoreLog Log;
+};
+
+template <typename Kind>
+struct SemaphoreHandleTraits<TypedSemaphoreHandle<Kind>> {
+    typedef typename Kind::Acquire Acquire;
+    typedef typename Kind::Log Log;
+};
+
+#endif  // _SEMAPHORE_HANDLES_H_
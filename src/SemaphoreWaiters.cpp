@@ -0,0 +1,28 @@
+#include "SemaphoreWaiters.h"
+#include <freertos/task.h>
+
+std::atomic<uint32_t> SemaphoreWaiters::s_waiting[SEMAPHORE_GUARD_WAITER_BUCKETS] = {};
+
+bool SemaphoreWaiters::take(SemaphoreHandle_t handle, TickType_t timeout, bool recursive) {
+    const bool taken = recursive ? xSemaphoreTakeRecursive(handle, 0) == pdTRUE
+                                 : xSemaphoreTake(handle, 0) == pdTRUE;
+    if (taken || timeout == 0) {
+        return taken;
+    }
+
+    enter(handle);
+    const bool result = recursive ? xSemaphoreTakeRecursive(handle, timeout) == pdTRUE
+                                  : xSemaphoreTake(handle, timeout) == pdTRUE;
+    leave(handle);
+    return result;
+}
+
+void SemaphoreWaiters::awaitHandOff(SemaphoreHandle_t handle, uint32_t waiting) {
+    // Equal-priority waiters on this core get in through the yield
+    taskYIELD();
+    // A waiter stops counting itself once its take returns
+    for (TickType_t waited = 0; waiting > 0 && count(handle) >= waiting &&
+                                waited < SEMAPHORE_GUARD_HANDOFF_TICKS; waited++) {
+        vTaskDelay(1);
+    }
+}
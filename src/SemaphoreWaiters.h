@@ -0,0 +1,70 @@
+#ifndef _SEMAPHORE_WAITERS_H_
+#define _SEMAPHORE_WAITERS_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <atomic>
+
+// Waiter counters; handles are hashed onto them. Must be a power of two
+#ifndef SEMAPHORE_GUARD_WAITER_BUCKETS
+#define SEMAPHORE_GUARD_WAITER_BUCKETS 32
+#endif
+
+// Ticks a hand-off waits at most for a waiter to take the semaphore
+#ifndef SEMAPHORE_GUARD_HANDOFF_TICKS
+#define SEMAPHORE_GUARD_HANDOFF_TICKS 2
+#endif
+
+static_assert((SEMAPHORE_GUARD_WAITER_BUCKETS & (SEMAPHORE_GUARD_WAITER_BUCKETS - 1)) == 0,
+              "SEMAPHORE_GUARD_WAITER_BUCKETS must be a power of two");
+
+// Which semaphores have tasks blocked on them.
+//
+// FreeRTOS does not tell a holder whether anyone waits for its semaphore,
+// so guards announce it themselves. Their take first tries without
+// blocking. Only when that fails does the task count itself as a waiter
+// for as long as it blocks. Uncontended takes cost what they did before,
+// and any() is a single atomic load.
+//
+// Handles share counters by hash, so any() can report waiters that belong
+// to another semaphore in the same bucket; it never misses a guard that
+// blocks. Raw xSemaphoreTake() calls outside guards are not seen.
+class SemaphoreWaiters {
+public:
+    // Take, counting the task as a waiter while it blocks
+    static bool take(SemaphoreHandle_t handle, TickType_t timeout, bool recursive);
+
+    // Bracket a blocking take made elsewhere
+    static void enter(SemaphoreHandle_t handle) {
+        bucket(handle).fetch_add(1, std::memory_order_relaxed);
+    }
+    static void leave(SemaphoreHandle_t handle) {
+        bucket(handle).fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // Check if a guard is blocked on handle (or on a handle sharing its bucket)
+    [[nodiscard]] static bool any(SemaphoreHandle_t handle) {
+        return bucket(handle).load(std::memory_order_relaxed) != 0;
+    }
+
+    // Guards blocked on handle (and on handles sharing its bucket)
+    [[nodiscard]] static uint32_t count(SemaphoreHandle_t handle) {
+        return bucket(handle).load(std::memory_order_relaxed);
+    }
+
+    // Call after giving a semaphore that `waiting` guards were blocked on:
+    // yields, then waits until one of them has taken it, at most
+    // SEMAPHORE_GUARD_HANDOFF_TICKS. Without the wait the giver could take
+    // it straight back before a waiter on the other core, or of lower
+    // priority, gets to run
+    static void awaitHandOff(SemaphoreHandle_t handle, uint32_t waiting);
+
+private:
+    static std::atomic<uint32_t>& bucket(SemaphoreHandle_t handle) {
+        // Kernel objects are word aligned
+        return s_waiting[(reinterpret_cast<uintptr_t>(handle) >> 2) & (SEMAPHORE_GUARD_WAITER_BUCKETS - 1)];
+    }
+
+    static std::atomic<uint32_t> s_waiting[SEMAPHORE_GUARD_WAITER_BUCKETS];
+};
+
+#endif  // _SEMAPHORE_WAITERS_H_
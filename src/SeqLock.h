@@ -0,0 +1,112 @@
+#ifndef _SEQ_LOCK_H_
+#define _SEQ_LOCK_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+#include <cstring>
+#include <type_traits>
+
+// Number of failed read attempts before a reader sleeps for one tick so a
+// preempted writer on the same core can finish its update
+#ifndef SEQLOCK_SPIN_LIMIT
+#define SEQLOCK_SPIN_LIMIT 64
+#endif
+
+// Sequence lock for small, frequently written snapshots (sensor state etc.).
+//
+// The writer never waits: it bumps the sequence to an odd value, copies the
+// data in and bumps it to even again. Readers copy the data out and retry if
+// the sequence changed underneath them, so a slow reader can no longer hold
+// up the writer the way it does with SEMAPHORE_GUARD().
+//
+// Only one writer may be active at a time. If several tasks write, serialize
+// them with a SemaphoreGuard around write(); readers stay lock-free.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "SeqLock<T> requires a trivially copyable T");
+
+public:
+    SeqLock() : m_sequence(0), m_data() {}
+    explicit SeqLock(const T& initial) : m_sequence(0), m_data(initial) {}
+
+    // Delete copy and move; readers and the writer refer to this instance
+    SeqLock(const SeqLock&) = delete;
+    SeqLock& operator=(const SeqLock&) = delete;
+    SeqLock(SeqLock&&) = delete;
+    SeqLock& operator=(SeqLock&&) = delete;
+
+    // RAII write access: the sequence is odd while the Writer is alive and
+    // the data may be modified in place through get() / operator->
+    class Writer {
+    public:
+        explicit Writer(SeqLock& lock) : m_lock(lock) { m_lock.beginWrite(); }
+        ~Writer() { m_lock.endWrite(); }
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+        Writer(Writer&&) = delete;
+        Writer& operator=(Writer&&) = delete;
+
+        T& get() noexcept { return m_lock.m_data; }
+        T* operator->() noexcept { return &m_lock.m_data; }
+
+    private:
+        SeqLock& m_lock;
+    };
+
+    // Publish a complete new value; never blocks
+    void write(const T& value) noexcept {
+        beginWrite();
+        std::memcpy(static_cast<void*>(&m_data), &value, sizeof(T));
+        endWrite();
+    }
+
+    // Single read attempt. Returns false if a write was in progress or
+    // completed during the copy; ISR-safe
+    [[nodiscard]] bool tryRead(T& out) const noexcept {
+        const uint32_t before = m_sequence.load(std::memory_order_acquire);
+        if (before & 1u) {
+            return false;
+        }
+        std::memcpy(static_cast<void*>(&out), &m_data, sizeof(T));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return m_sequence.load(std::memory_order_relaxed) == before;
+    }
+
+    // Return a consistent copy, retrying until no write overlapped the read.
+    // Must not be called from an ISR (it may sleep for a tick)
+    [[nodiscard]] T read() const {
+        T out;
+        uint32_t attempts = 0;
+        while (!tryRead(out)) {
+            if (++attempts >= SEQLOCK_SPIN_LIMIT) {
+                attempts = 0;
+                vTaskDelay(1);
+            }
+        }
+        return out;
+    }
+
+    // Current sequence number (even when idle); advances by 2 per write
+    [[nodiscard]] uint32_t sequence() const noexcept {
+        return m_sequence.load(std::memory_order_acquire);
+    }
+
+private:
+    void beginWrite() noexcept {
+        const uint32_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    void endWrite() noexcept {
+        const uint32_t seq = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(seq + 1, std::memory_order_release);
+    }
+
+    std::atomic<uint32_t> m_sequence;
+    T m_data;
+};
+
+#endif  // _SEQ_LOCK_H_
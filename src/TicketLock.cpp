@@ -0,0 +1,157 @@
+#include "TicketLock.h"
+#include "CriticalSectionGuard.h"
+
+TicketLock::TicketLock()
+    : m_owner(nullptr), m_head(nullptr), m_tail(nullptr), m_count(0), m_handoffs(0) {
+    portMUX_INITIALIZE(&m_mux);
+}
+
+bool TicketLock::lock(TickType_t timeout) {
+    if (xPortInIsrContext()) {
+        TLK_LOG_E("Cannot use TicketLock in ISR context");
+        return false;
+    }
+
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    Waiter waiter;
+    bool recursive = false;
+    bool queued = false;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        if (m_owner == nullptr) {
+            // Free implies an empty queue: unlock() never frees the lock
+            // while anyone is waiting
+            m_owner = self;
+            return true;
+        }
+        recursive = (m_owner == self);
+        if (!recursive && timeout != 0) {
+            waiter.task = self;
+            waiter.next = nullptr;
+            waiter.prev = m_tail;
+            waiter.state.store(Spinning, std::memory_order_relaxed);
+            if (m_tail != nullptr) {
+                m_tail->next = &waiter;
+            } else {
+                m_head = &waiter;
+            }
+            m_tail = &waiter;
+            m_count++;
+            queued = true;
+        }
+    }
+
+    if (recursive) {
+        TLK_LOG_E("TicketLock is not recursive; task already owns it");
+        return false;
+    }
+    return queued && wait(waiter, timeout);
+}
+
+bool TicketLock::wait(Waiter& waiter, TickType_t timeout) {
+    for (int i = 0; i < TICKET_LOCK_SPIN_LIMIT; i++) {
+        if (waiter.state.load(std::memory_order_acquire) == Granted) {
+            return true;
+        }
+    }
+
+    // Announce that a notification is needed; fails only if granted meanwhile
+    uint8_t expected = Spinning;
+    if (!waiter.state.compare_exchange_strong(expected, Sleeping, std::memory_order_acq_rel)) {
+        return true;
+    }
+
+    TimeOut_t start;
+    vTaskSetTimeOutState(&start);
+    TickType_t remaining = timeout;
+    bool notified = false;  // Set once a take returned a notification
+    while (true) {
+        notified = ulTaskNotifyTake(pdTRUE, remaining) != 0;
+        if (waiter.state.load(std::memory_order_acquire) == Granted) {
+            return consumeGrant(notified);
+        }
+        // Unrelated notifications land here too; keep waiting
+        if (timeout != portMAX_DELAY && xTaskCheckForTimeOut(&start, &remaining) == pdTRUE) {
+            break;
+        }
+    }
+
+    {
+        CriticalSectionGuard guard(&m_mux);
+        if (waiter.state.load(std::memory_order_acquire) != Granted) {
+            unlink(waiter);
+            return false;
+        }
+    }
+
+    // Granted as the timeout expired: we own the lock
+    return consumeGrant(false);
+}
+
+bool TicketLock::consumeGrant(bool notified) {
+    // Every grant of a sleeping waiter is followed by a give from unlock().
+    // If the last take did not return it, it is still on its way and must be
+    // consumed so it cannot wake a later wait
+    if (!notified) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+    return true;
+}
+
+void TicketLock::unlock() {
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    TaskHandle_t owner;
+    TaskHandle_t wake = nullptr;
+    {
+        CriticalSectionGuard guard(&m_mux);
+        owner = m_owner;
+        if (owner == self) {
+            Waiter* next = m_head;
+            if (next == nullptr) {
+                m_owner = nullptr;
+            } else {
+                unlink(*next);
+                // Copy the task out first: once granted, the waiter may
+                // return and its stack record is gone
+                const TaskHandle_t task = next->task;
+                m_owner = task;
+                if (next->state.exchange(Granted, std::memory_order_acq_rel) == Sleeping) {
+                    wake = task;
+                }
+                m_handoffs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (owner != self) {
+        TLK_LOG_E("unlock() called by a task that does not own the lock");
+        return;
+    }
+    if (wake != nullptr) {
+        xTaskNotifyGive(wake);
+    }
+}
+
+void TicketLock::unlink(Waiter& waiter) {
+    if (waiter.prev != nullptr) {
+        waiter.prev->next = waiter.next;
+    } else {
+        m_head = waiter.next;
+    }
+    if (waiter.next != nullptr) {
+        waiter.next->prev = waiter.prev;
+    } else {
+        m_tail = waiter.prev;
+    }
+    m_count--;
+}
+
+bool TicketLock::isLocked() const {
+    CriticalSectionGuard guard(&m_mux);
+    return m_owner != nullptr;
+}
+
+size_t TicketLock::waiters() const {
+    CriticalSectionGuard guard(&m_mux);
+    return m_count;
+}
@@ -0,0 +1,143 @@
+#ifndef _TICKET_LOCK_H_
+#define _TICKET_LOCK_H_
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <atomic>
+
+// Include the logging configuration
+#include "SemaphoreGuardLogging.h"
+#include "Deadline.h"
+
+// Number of polls of the waiter's grant flag before blocking. Spinning only
+// pays off when the owner runs on the other core and holds the lock briefly
+#ifndef TICKET_LOCK_SPIN_LIMIT
+#define TICKET_LOCK_SPIN_LIMIT 100
+#endif
+
+// Fair lock that grants strictly in arrival order.
+//
+// A FreeRTOS mutex wakes the highest-priority waiter and lets a task that
+// just released the lock take it straight back, so two busy tasks on
+// different cores can starve a third of equal priority. TicketLock queues
+// every waiter (its ticket) and unlock() hands ownership directly to the
+// head of the queue; the lock is never free while anyone is waiting, so
+// nobody can barge in.
+//
+// Waiters spin briefly on their own grant flag, then block on their task
+// notification. A waiter that times out leaves the queue, so an abandoned
+// ticket never stalls the tasks behind it. The queue nodes live on the
+// waiting tasks' stacks; nothing is allocated.
+//
+// No priority inheritance: a low-priority owner can delay high-priority
+// waiters. Like ConditionVariable, waiting uses the task's default
+// notification slot. Not for use from ISRs.
+class TicketLock {
+public:
+    TicketLock();
+
+    // Delete copy and move; waiters refer to this instance
+    TicketLock(const TicketLock&) = delete;
+    TicketLock& operator=(const TicketLock&) = delete;
+    TicketLock(TicketLock&&) = delete;
+    TicketLock& operator=(TicketLock&&) = delete;
+
+    // Wait up to timeout ticks for the lock; returns true when acquired
+    bool lock(TickType_t timeout = portMAX_DELAY);
+
+    // Take the lock only if it is free and nobody is queued
+    bool tryLock() { return lock(0); }
+
+    // Release, handing the lock to the longest waiter if there is one.
+    // Only the owning task may call this
+    void unlock();
+
+    // Check if any task holds the lock
+    [[nodiscard]] bool isLocked() const;
+
+    // Tasks currently queued
+    [[nodiscard]] size_t waiters() const;
+
+    // Direct owner-to-waiter handoffs so far
+    [[nodiscard]] uint32_t handoffs() const noexcept { return m_handoffs.load(std::memory_order_relaxed); }
+
+private:
+    enum State : uint8_t { Spinning, Sleeping, Granted };
+
+    struct Waiter {
+        TaskHandle_t task;
+        Waiter* next;
+        Waiter* prev;
+        std::atomic<uint8_t> state;
+    };
+
+    bool wait(Waiter& waiter, TickType_t timeout);
+    static bool consumeGrant(bool notified);
+    void unlink(Waiter& waiter);
+
+    TaskHandle_t m_owner;  // Guarded by m_mux, nullptr when free
+    Waiter* m_head;        // FIFO of waiting tasks, guarded by m_mux
+    Waiter* m_tail;
+    size_t m_count;
+    std::atomic<uint32_t> m_handoffs;
+    mutable portMUX_TYPE m_mux;
+};
+
+// RAII guard for TicketLock with the same shape as SemaphoreGuard
+class TicketLockGuard {
+public:
+    // Constructor: Waits for the lock without limit
+    explicit TicketLockGuard(TicketLock& lock) : m_lock(lock), m_taken(lock.lock(portMAX_DELAY)) {}
+
+    // Constructor: Waits for the lock at most timeout ticks
+    TicketLockGuard(TicketLock& lock, TickType_t timeout) : m_lock(lock), m_taken(lock.lock(timeout)) {}
+
+    // Constructor: Waits using only the time left before the deadline
+    TicketLockGuard(TicketLock& lock, const Deadline& deadline)
+        : m_lock(lock), m_taken(lock.lock(deadline.remaining())) {}
+
+    // Destructor: Releases the lock if held
+    ~TicketLockGuard() {
+        if (m_taken) {
+            m_lock.unlock();
+        }
+    }
+
+    // Delete copy constructor and copy assignment to prevent double-release
+    TicketLockGuard(const TicketLockGuard&) = delete;
+    TicketLockGuard& operator=(const TicketLockGuard&) = delete;
+
+    // Delete move constructor and move assignment for safety
+    TicketLockGuard(TicketLockGuard&&) = delete;
+    TicketLockGuard& operator=(TicketLockGuard&&) = delete;
+
+    // Check if the lock was successfully acquired
+    [[nodiscard]] bool hasLock() const noexcept { return m_taken; }
+
+    // Get the lock (for advanced use cases)
+    [[nodiscard]] TicketLock& getLock() const noexcept { return m_lock; }
+
+    // Release early; the destructor then does nothing unless lock() is called
+    void unlock() {
+        if (m_taken) {
+            m_lock.unlock();
+            m_taken = false;
+        }
+    }
+
+    // Take the lock again after unlock(); returns hasLock()
+    bool lock(TickType_t timeout = portMAX_DELAY) {
+        if (!m_taken) {
+            m_taken = m_lock.lock(timeout);
+        }
+        return m_taken;
+    }
+
+private:
+    TicketLock& m_lock;
+    bool m_taken;  // Indicates whether the lock was successfully taken
+};
+
+#define TICKET_LOCK_GUARD(lock) TicketLockGuard guard(lock)
+#define TICKET_LOCK_GUARD_TIMEOUT(lock, timeout) TicketLockGuard guard(lock, timeout)
+
+#endif  // _TICKET_LOCK_H_
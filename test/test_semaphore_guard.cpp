@@ -7,7 +7,31 @@
 
 #include <Arduino.h>
 #include <unity.h>
+#include <freertos/queue.h>
 #include <SemaphoreGuard.h>
+#include <RecursiveSemaphoreGuard.h>
+#include <SeqLock.h>
+#include <RcuStore.h>
+#include <IsrSemaphoreGuard.h>
+#include <CriticalSectionGuard.h>
+#include <FlatCombiner.h>
+#include <AsyncLockDispatcher.h>
+#include <SemaphoreArena.h>
+#include <LazySemaphore.h>
+#include <ConditionVariable.h>
+#include <TicketLock.h>
+#include <McsLock.h>
+#include <PriorityCeilingGuard.h>
+#include <LockRank.h>
+#include <HeldLockTable.h>
+#include <DeadlockDetector.h>
+#include <ContentionProfiler.h>
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+#include <HeldList.h>
+#endif
+#include <RecursiveOwnership.h>
+#include <BatchingGuard.h>
+#include <AsyncSemaphore.h>
 
 static SemaphoreHandle_t binarySem = nullptr;
 static SemaphoreHandle_t countingSem = nullptr;
@@ -57,6 +81,8 @@ void test_semaphore_guard_timeout() {
     xSemaphoreGive(binarySem);
 }
 
+// Null handles are only survivable with full validation
+#if SEMAPHORE_GUARD_VALIDATION >= 2
 void test_semaphore_guard_null_handle() {
     SemaphoreGuard guard(nullptr);
     TEST_ASSERT_FALSE(guard.hasLock());
@@ -70,6 +96,7 @@ void test_semaphore_guard_is_valid() {
     TEST_ASSERT_TRUE(validGuard.isValid());
     TEST_ASSERT_FALSE(invalidGuard.isValid());
 }
+#endif
 
 void test_semaphore_guard_get_handle() {
     SemaphoreGuard guard(binarySem);
@@ -136,6 +163,917 @@ void test_semaphore_guard_signaling_pattern() {
     vSemaphoreDelete(signal);
 }
 
+void test_seqlock_read_returns_written_value() {
+    struct Sample { uint32_t a; uint32_t b; };
+    SeqLock<Sample> lock;
+
+    lock.write(Sample{1, 2});
+    Sample copy = lock.read();
+    TEST_ASSERT_EQUAL(1, copy.a);
+    TEST_ASSERT_EQUAL(2, copy.b);
+
+    // Each completed write advances the sequence by two
+    TEST_ASSERT_EQUAL(2, lock.sequence());
+}
+
+void test_seqlock_try_read_fails_during_write() {
+    SeqLock<uint32_t> lock(7);
+    uint32_t value = 0;
+
+    {
+        SeqLock<uint32_t>::Writer writer(lock);
+        writer.get() = 42;
+        TEST_ASSERT_FALSE(lock.tryRead(value));
+    }
+
+    TEST_ASSERT_TRUE(lock.tryRead(value));
+    TEST_ASSERT_EQUAL(42, value);
+}
+
+void test_rcu_store_reader_keeps_old_version() {
+    RcuStore<uint32_t> store(1);
+
+    {
+        RcuStore<uint32_t>::ReadGuard reader(store);
+        TEST_ASSERT_TRUE(store.update(2, pdMS_TO_TICKS(10)));
+
+        // The pinned version is unchanged while new readers see the update
+        TEST_ASSERT_EQUAL(1, *reader);
+        TEST_ASSERT_EQUAL(2, store.read());
+        TEST_ASSERT_EQUAL(1, store.activeReaders());
+    }
+
+    TEST_ASSERT_EQUAL(0, store.activeReaders());
+}
+
+void test_rcu_store_update_times_out_when_all_versions_pinned() {
+    RcuStore<uint32_t, 2> store(1);
+
+    RcuStore<uint32_t, 2>::ReadGuard first(store);
+    TEST_ASSERT_TRUE(store.update(2, pdMS_TO_TICKS(10)));
+    RcuStore<uint32_t, 2>::ReadGuard second(store);
+
+    // Both versions are pinned, so there is no slot to publish into
+    TEST_ASSERT_FALSE(store.update(3, pdMS_TO_TICKS(10)));
+}
+
+void test_isr_semaphore_guard_refuses_task_context() {
+    xSemaphoreTake(binarySem, 0);  // Empty, so a stray give would show
+    {
+        IsrSemaphoreGuard guard(binarySem);
+        TEST_ASSERT_FALSE(guard.hasLock());
+        TEST_ASSERT_TRUE(guard.isValid());
+    }
+    TEST_ASSERT_EQUAL(0, uxSemaphoreGetCount(binarySem));
+}
+
+void test_isr_semaphore_guard_null_handle() {
+    IsrYieldScope scope;
+    IsrSemaphoreGuard guard(nullptr, scope);
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_FALSE(guard.isValid());
+    TEST_ASSERT_FALSE(scope.yieldRequested());
+}
+
+void test_critical_section_guard_acquires_and_releases() {
+    static portMUX_TYPE mux = portMUX_INITIALIZER_UNLOCKED;
+
+    // Assert only after the section closes: a failing assertion would
+    // leave it with interrupts disabled
+    bool locked = false;
+    portMUX_TYPE* handle = nullptr;
+    {
+        CriticalSectionGuard guard(&mux);
+        locked = guard.hasLock();
+        handle = guard.getHandle();
+    }
+    TEST_ASSERT_TRUE(locked);
+    TEST_ASSERT_EQUAL_PTR(&mux, handle);
+
+    // Released by the destructor, so it can be taken again
+    bool relocked = false;
+    {
+        CriticalSectionGuard again(&mux);
+        relocked = again.hasLock();
+    }
+    TEST_ASSERT_TRUE(relocked);
+}
+
+void test_critical_section_guard_null_handle() {
+    CriticalSectionGuard guard(nullptr);
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_FALSE(guard.isValid());
+}
+
+static void incrementCounter(void* arg) {
+    (*static_cast<uint32_t*>(arg))++;
+}
+
+void test_flat_combiner_runs_operation() {
+    static FlatCombiner<4> combiner;
+    uint32_t counter = 0;
+
+    TEST_ASSERT_TRUE(combiner.execute(incrementCounter, &counter));
+    TEST_ASSERT_TRUE(combiner.execute(incrementCounter, &counter, pdMS_TO_TICKS(10)));
+    TEST_ASSERT_EQUAL(2, counter);
+
+    // Uncontended calls combine only their own operation
+    TEST_ASSERT_EQUAL(2, combiner.combinedOperations());
+    combiner.detach();
+}
+
+// 0 = not called, 1 = called with lock, 2 = called after timeout
+static volatile int asyncResult = 0;
+
+static void recordAsyncResult(SemaphoreGuard& guard, void*) {
+    asyncResult = guard.hasLock() ? 1 : 2;
+}
+
+void test_async_acquire_runs_callback_with_lock() {
+    TEST_ASSERT_TRUE(AsyncLockDispatcher::instance().begin());
+    asyncResult = 0;
+
+    TEST_ASSERT_TRUE(asyncAcquire(binarySem, recordAsyncResult, nullptr, pdMS_TO_TICKS(100)));
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    TEST_ASSERT_EQUAL(1, asyncResult);
+    TEST_ASSERT_EQUAL(0, AsyncLockDispatcher::instance().pending());
+}
+
+void test_async_acquire_reports_timeout() {
+    TEST_ASSERT_TRUE(AsyncLockDispatcher::instance().begin());
+    asyncResult = 0;
+    xSemaphoreTake(binarySem, portMAX_DELAY);
+
+    TEST_ASSERT_TRUE(asyncAcquire(binarySem, recordAsyncResult, nullptr, pdMS_TO_TICKS(10)));
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    TEST_ASSERT_EQUAL(2, asyncResult);
+    xSemaphoreGive(binarySem);
+}
+
+void test_semaphore_guard_deadline_acquires_with_budget() {
+    Deadline deadline(pdMS_TO_TICKS(100));
+    SemaphoreGuard guard(binarySem, deadline);
+
+    TEST_ASSERT_TRUE(guard.hasLock());
+    TEST_ASSERT_FALSE(guard.deadlineExpired());
+}
+
+void test_semaphore_guard_deadline_shared_across_guards() {
+    xSemaphoreTake(binarySem, portMAX_DELAY);
+    Deadline deadline(pdMS_TO_TICKS(20));
+
+    // First guard consumes the whole budget
+    SemaphoreGuard first(binarySem, deadline);
+    TEST_ASSERT_FALSE(first.hasLock());
+    TEST_ASSERT_TRUE(first.deadlineExpired());
+    TEST_ASSERT_TRUE(deadline.expired());
+
+    // Second guard gets no additional wait time
+    TickType_t before = xTaskGetTickCount();
+    SemaphoreGuard second(binarySem, deadline);
+    TEST_ASSERT_FALSE(second.hasLock());
+    TEST_ASSERT_TRUE(second.deadlineExpired());
+    TEST_ASSERT_LESS_OR_EQUAL(1, xTaskGetTickCount() - before);
+
+    xSemaphoreGive(binarySem);
+}
+
+void test_semaphore_arena_creates_usable_handles() {
+    static SemaphoreArena<2> arena;
+    {
+        ArenaSemaphore mutex = arena.createMutex();
+        ArenaSemaphore counting = arena.createCounting(2, 2);
+        TEST_ASSERT_TRUE(mutex.isValid());
+        TEST_ASSERT_TRUE(counting.isValid());
+        TEST_ASSERT_EQUAL(2, arena.inUse());
+
+        SemaphoreGuard guard(mutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+    }
+    TEST_ASSERT_EQUAL(0, arena.inUse());
+    TEST_ASSERT_EQUAL(2, arena.getStats().highWater);
+}
+
+void test_semaphore_arena_full_returns_invalid_handle() {
+    static SemaphoreArena<1> arena;
+    ArenaSemaphore first = arena.createBinary();
+    ArenaSemaphore second = arena.createBinary();
+
+    TEST_ASSERT_TRUE(first.isValid());
+    TEST_ASSERT_FALSE(second.isValid());
+    TEST_ASSERT_EQUAL(1, arena.getStats().failed);
+
+    // A released slot is handed out again
+    first.reset();
+    ArenaSemaphore third = arena.createRecursiveMutex();
+    TEST_ASSERT_TRUE(third.isValid());
+}
+
+void test_lazy_semaphore_creates_on_first_guard() {
+    static LazySemaphore lazy;
+    TEST_ASSERT_FALSE(lazy.isCreated());
+
+    {
+        SemaphoreGuard guard(lazy);
+        TEST_ASSERT_TRUE(guard.hasLock());
+    }
+    TEST_ASSERT_TRUE(lazy.isCreated());
+
+    // Later uses see the same kernel object
+    SemaphoreHandle_t first = lazy.get();
+    TEST_ASSERT_EQUAL_PTR(first, lazy.get());
+}
+
+void test_lazy_semaphore_recursive_mutex() {
+    static LazySemaphore lazy(LazySemaphore::Type::RecursiveMutex);
+
+    RecursiveSemaphoreGuard outer(lazy);
+    RecursiveSemaphoreGuard inner(lazy);
+    TEST_ASSERT_TRUE(outer.hasLock());
+    TEST_ASSERT_TRUE(inner.hasLock());
+}
+
+void test_typed_handles_select_guard_type() {
+    RecursiveMutexHandle recursive = createRecursiveMutex();
+    MutexHandle mutex = createMutex();
+
+    TEST_ASSERT_TRUE((std::is_same<SemaphoreGuardFor<RecursiveMutexHandle>, RecursiveSemaphoreGuard>::value));
+    TEST_ASSERT_TRUE((std::is_same<SemaphoreGuardFor<MutexHandle>, SemaphoreGuard>::value));
+    TEST_ASSERT_TRUE((std::is_same<SemaphoreGuardFor<SemaphoreHandle_t>, SemaphoreGuard>::value));
+
+    {
+        // Nested acquisition only works because the recursive take is chosen
+        SEMAPHORE_GUARD(recursive);
+        SemaphoreGuardFor<RecursiveMutexHandle> inner(recursive, (TickType_t)0);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_TRUE(inner.hasLock());
+    }
+    {
+        SemaphoreGuard guard(mutex);
+        TEST_ASSERT_TRUE(guard.hasLock());
+    }
+
+    recursive.destroy();
+    mutex.destroy();
+    TEST_ASSERT_FALSE(recursive.isValid());
+}
+
+static ConditionVariable cvReady;
+static SemaphoreHandle_t cvMutex = nullptr;
+static volatile bool cvFlag = false;
+
+static void cvNotifierTask(void*) {
+    vTaskDelay(pdMS_TO_TICKS(10));
+    {
+        SemaphoreGuard guard(cvMutex);
+        cvFlag = true;
+    }
+    cvReady.notifyOne();
+    vTaskDelete(nullptr);
+}
+
+void test_condition_variable_wakes_waiter() {
+    cvMutex = xSemaphoreCreateMutex();
+    cvFlag = false;
+    xTaskCreate(cvNotifierTask, "notifier", 2048, nullptr, 1, nullptr);
+
+    SemaphoreGuard guard(cvMutex);
+    const bool ready = cvReady.waitFor(guard, pdMS_TO_TICKS(1000), [] { return cvFlag; });
+
+    TEST_ASSERT_TRUE(ready);
+    TEST_ASSERT_TRUE(guard.hasLock());
+    TEST_ASSERT_EQUAL(0, cvReady.waiters());
+}
+
+void test_condition_variable_wait_for_times_out() {
+    SemaphoreGuard guard(binarySem);
+    const bool notified = cvReady.waitFor(guard, pdMS_TO_TICKS(20));
+
+    TEST_ASSERT_FALSE(notified);
+    TEST_ASSERT_TRUE(guard.hasLock());
+    TEST_ASSERT_EQUAL(0, cvReady.waiters());
+}
+
+static TaskHandle_t cvWaiterHandles[2];
+static volatile bool cvWaiterNotified[2];
+static volatile bool cvWaiterDone[2];
+static volatile uint32_t cvWaiterStray = 0;
+
+static void cvWaiterTask(void* param) {
+    const int index = static_cast<int>(reinterpret_cast<intptr_t>(param));
+    {
+        SemaphoreGuard guard(cvMutex);
+        cvWaiterNotified[index] = cvReady.waitFor(guard, pdMS_TO_TICKS(1000));
+    }
+    if (index == 0) {
+        // Unrelated give to the second waiter, which notifyAll() has picked
+        // but not signalled yet
+        xTaskNotifyGive(cvWaiterHandles[1]);
+    } else {
+        // A notifier signal left over from the wait would show up here
+        cvWaiterStray = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(20));
+    }
+    cvWaiterDone[index] = true;
+    vTaskDelete(nullptr);
+}
+
+void test_condition_variable_ignores_unrelated_give_while_notified() {
+    cvMutex = xSemaphoreCreateMutex();
+    cvWaiterStray = 0;
+    for (int i = 0; i < 2; i++) {
+        cvWaiterNotified[i] = false;
+        cvWaiterDone[i] = false;
+        // Same core, higher priority: each runs as soon as it is signalled
+        xTaskCreatePinnedToCore(cvWaiterTask, "cvwaiter", 2048, reinterpret_cast<void*>(static_cast<intptr_t>(i)),
+                                uxTaskPriorityGet(nullptr) + 1, &cvWaiterHandles[i], xPortGetCoreID());
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    TEST_ASSERT_EQUAL(2, cvReady.waiters());
+
+    // The first waiter runs on its signal and gives the second one before
+    // this task signals it
+    cvReady.notifyAll();
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    TEST_ASSERT_TRUE(cvWaiterDone[0]);
+    TEST_ASSERT_TRUE(cvWaiterDone[1]);
+    TEST_ASSERT_TRUE(cvWaiterNotified[0]);
+    TEST_ASSERT_TRUE(cvWaiterNotified[1]);
+    TEST_ASSERT_EQUAL(0, cvWaiterStray);
+    TEST_ASSERT_EQUAL(0, cvReady.waiters());
+    vSemaphoreDelete(cvMutex);
+}
+
+void test_semaphore_guard_unlock_and_relock() {
+    SemaphoreGuard guard(binarySem);
+    TEST_ASSERT_TRUE(guard.hasLock());
+
+    guard.unlock();
+    TEST_ASSERT_FALSE(guard.hasLock());
+    TEST_ASSERT_EQUAL(1, uxSemaphoreGetCount(binarySem));
+
+    TEST_ASSERT_TRUE(guard.lock(pdMS_TO_TICKS(10)));
+    TEST_ASSERT_EQUAL(0, uxSemaphoreGetCount(binarySem));
+}
+
+static TicketLock ticketLock;
+static volatile int ticketOrder[2];
+static volatile int ticketOrderCount = 0;
+
+static void ticketWaiterTask(void* param) {
+    TicketLockGuard guard(ticketLock);
+    ticketOrder[ticketOrderCount] = static_cast<int>(reinterpret_cast<intptr_t>(param));
+    ticketOrderCount = ticketOrderCount + 1;
+    guard.unlock();
+    vTaskDelete(nullptr);
+}
+
+void test_ticket_lock_grants_in_arrival_order() {
+    ticketOrderCount = 0;
+    {
+        TicketLockGuard guard(ticketLock);
+        TEST_ASSERT_TRUE(guard.hasLock());
+
+        // Queue a low-priority task first, then a high-priority one
+        xTaskCreate(ticketWaiterTask, "first", 2048, reinterpret_cast<void*>(1), 2, nullptr);
+        vTaskDelay(pdMS_TO_TICKS(10));
+        xTaskCreate(ticketWaiterTask, "second", 2048, reinterpret_cast<void*>(2), 3, nullptr);
+        vTaskDelay(pdMS_TO_TICKS(10));
+        TEST_ASSERT_EQUAL(2, ticketLock.waiters());
+    }
+    vTaskDelay(pdMS_TO_TICKS(20));
+
+    TEST_ASSERT_EQUAL(2, ticketOrderCount);
+    TEST_ASSERT_EQUAL(1, ticketOrder[0]);
+    TEST_ASSERT_EQUAL(2, ticketOrder[1]);
+    TEST_ASSERT_FALSE(ticketLock.isLocked());
+}
+
+void test_ticket_lock_guard_times_out() {
+    TicketLockGuard owner(ticketLock);
+    TEST_ASSERT_TRUE(owner.hasLock());
+
+    xTaskCreate([](void*) {
+        TicketLockGuard guard(ticketLock, pdMS_TO_TICKS(10));
+        ticketOrderCount = guard.hasLock() ? -1 : -2;
+        vTaskDelete(nullptr);
+    }, "timeout", 2048, nullptr, 2, nullptr);
+    vTaskDelay(pdMS_TO_TICKS(30));
+
+    TEST_ASSERT_EQUAL(-2, ticketOrderCount);
+    TEST_ASSERT_EQUAL(0, ticketLock.waiters());
+}
+
+static McsLock mcsLock;
+static volatile int mcsResult = 0;
+
+static void mcsTimeoutTask(void*) {
+    {
+        McsLockGuard guard(mcsLock, pdMS_TO_TICKS(10));
+        mcsResult = guard.hasLock() ? 1 : 2;
+    }
+    // Destructor returned without waiting for the owner
+    mcsResult = mcsResult + 10;
+    vTaskDelete(nullptr);
+}
+
+void test_mcs_lock_guard_acquires_and_releases() {
+    {
+        MCS_LOCK_GUARD(mcsLock);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_TRUE(mcsLock.isLocked());
+
+        McsLockGuard other(mcsLock, (TickType_t)0);
+        TEST_ASSERT_FALSE(other.hasLock());
+    }
+    TEST_ASSERT_FALSE(mcsLock.isLocked());
+}
+
+void test_mcs_lock_abandoned_waiter_is_skipped() {
+    mcsResult = 0;
+    {
+        McsLockGuard owner(mcsLock);
+        xTaskCreate(mcsTimeoutTask, "mcs", 2048, nullptr, 2, nullptr);
+        vTaskDelay(pdMS_TO_TICKS(30));
+
+        // Timed out and already left its scope; the pooled node stays
+        // queued until the owner passes it
+        TEST_ASSERT_EQUAL(12, mcsResult);
+        TEST_ASSERT_TRUE(mcsLock.isLocked());
+    }
+
+    TEST_ASSERT_FALSE(mcsLock.isLocked());
+
+    // The skipped node went back to the pool and can be used again
+    McsLockGuard again(mcsLock, (TickType_t)0);
+    TEST_ASSERT_TRUE(again.hasLock());
+}
+
+void test_priority_ceiling_guard_raises_and_restores() {
+    const UBaseType_t base = uxTaskPriorityGet(nullptr);
+    {
+        const CeilingLock lock = {binarySem, base + 2};
+        PRIORITY_CEILING_GUARD(lock);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_TRUE(guard.isBoosted());
+        TEST_ASSERT_EQUAL(base + 2, uxTaskPriorityGet(nullptr));
+
+        // Nested: a lower ceiling leaves the priority alone
+        PriorityCeilingGuard inner(countingSem, base + 1);
+        TEST_ASSERT_TRUE(inner.hasLock());
+        TEST_ASSERT_FALSE(inner.isBoosted());
+        TEST_ASSERT_EQUAL(base + 2, uxTaskPriorityGet(nullptr));
+    }
+    TEST_ASSERT_EQUAL(base, uxTaskPriorityGet(nullptr));
+}
+
+void test_priority_ceiling_guard_restores_on_timeout() {
+    const UBaseType_t base = uxTaskPriorityGet(nullptr);
+    SemaphoreGuard owner(binarySem);
+    TEST_ASSERT_TRUE(owner.hasLock());
+    {
+        PriorityCeilingGuard guard(binarySem, base + 2, (TickType_t)0);
+        TEST_ASSERT_FALSE(guard.hasLock());
+        TEST_ASSERT_FALSE(guard.isBoosted());
+        TEST_ASSERT_EQUAL(base, uxTaskPriorityGet(nullptr));
+    }
+    TEST_ASSERT_EQUAL(base, uxTaskPriorityGet(nullptr));
+}
+
+#if configUSE_TRACE_FACILITY
+static SemaphoreHandle_t ceilingMutex = nullptr;
+
+static void ceilingInheritorTask(void*) {
+    {
+        SemaphoreGuard guard(ceilingMutex);
+    }
+    vTaskDelete(nullptr);
+}
+
+void test_priority_boost_ignores_inherited_priority() {
+    const UBaseType_t base = uxTaskPriorityGet(nullptr);
+    ceilingMutex = xSemaphoreCreateMutex();
+    UBaseType_t inherited = 0;
+    UBaseType_t previous = 0;
+    {
+        SemaphoreGuard owner(ceilingMutex);
+        // Blocks on the mutex at once, lending this task its priority
+        xTaskCreatePinnedToCore(ceilingInheritorTask, "inheritor", 2048, nullptr, base + 2, nullptr,
+                                xPortGetCoreID());
+        inherited = uxTaskPriorityGet(nullptr);
+
+        PriorityBoost boost(base + 3);
+        previous = boost.previous();
+    }
+    vTaskDelay(pdMS_TO_TICKS(10));
+    vSemaphoreDelete(ceilingMutex);
+
+    TEST_ASSERT_EQUAL(base + 2, inherited);
+    TEST_ASSERT_EQUAL(base, previous);
+    TEST_ASSERT_EQUAL(base, uxTaskPriorityGet(nullptr));
+}
+#endif
+
+static RankedLock<10> rankedLow;
+static RankedLock<20> rankedHigh;
+static RankedLock<30> rankedTop;
+
+static void createRankedLocks() {
+    if (!rankedLow.isValid()) {
+        rankedLow = RankedLock<10>(xSemaphoreCreateMutex());
+        rankedHigh = RankedLock<20>(xSemaphoreCreateMutex());
+        rankedTop = RankedLock<30>(xSemaphoreCreateMutex());
+    }
+}
+
+void test_ranked_guard_allows_increasing_order() {
+    createRankedLocks();
+    {
+        RankedGuard<10> low(rankedLow);
+        TEST_ASSERT_TRUE(low.hasLock());
+
+        // Nesting checked at compile time
+        RankedGuard<20> high(rankedHigh, low);
+        TEST_ASSERT_TRUE(high.hasLock());
+    }
+    {
+        // Nesting checked at runtime
+        RANKED_GUARD(rankedLow);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        RankedGuard<20> high(rankedHigh, pdMS_TO_TICKS(10));
+        TEST_ASSERT_TRUE(high.hasLock());
+    }
+}
+
+void test_ranked_guard_rejects_lower_rank() {
+#if SEMAPHORE_GUARD_RANK_CHECKS
+    createRankedLocks();
+    const uint32_t before = LockRankTracker::violations();
+    {
+        RankedGuard<20> high(rankedHigh);
+        TEST_ASSERT_TRUE(high.hasLock());
+
+        RankedGuard<10> low(rankedLow, pdMS_TO_TICKS(10));
+        TEST_ASSERT_FALSE(low.hasLock());
+        TEST_ASSERT_EQUAL(before + 1, LockRankTracker::violations());
+    }
+    TEST_ASSERT_EQUAL(0, LockRankTracker::held());
+
+    {
+        // The compile-time check passes (20 > 10), but rank 30 is held
+        RankedGuard<10> low(rankedLow);
+        RankedGuard<30> top(rankedTop);
+        RankedGuard<20> nested(rankedHigh, low, pdMS_TO_TICKS(10));
+        TEST_ASSERT_FALSE(nested.hasLock());
+        TEST_ASSERT_EQUAL(30, LockRankTracker::held());
+    }
+    {
+        // A nested guard whose enclosing guard was refused refuses too
+        RankedGuard<30> top(rankedTop);
+        RankedGuard<10> low(rankedLow, pdMS_TO_TICKS(10));
+        RankedGuard<20> nested(rankedHigh, low, pdMS_TO_TICKS(10));
+        TEST_ASSERT_FALSE(low.hasLock());
+        TEST_ASSERT_FALSE(nested.hasLock());
+        TEST_ASSERT_EQUAL(30, LockRankTracker::held());
+    }
+    TEST_ASSERT_EQUAL(0, LockRankTracker::held());
+
+    // Released in order: the lower rank is allowed again
+    RankedGuard<10> low(rankedLow);
+    TEST_ASSERT_TRUE(low.hasLock());
+#endif
+}
+
+typedef BasicSemaphoreGuard<SemaphoreAcquire, NoTiming, HeldLockRecorder, SemaphoreLog> RecordedGuard;
+
+void test_held_lock_table_records_and_survives_reset() {
+    HeldLockTable::begin();
+    {
+        RecordedGuard guard(binarySem);
+        TEST_ASSERT_TRUE(guard.hasLock());
+        TEST_ASSERT_EQUAL(1, HeldLockTable::heldCount());
+    }
+    TEST_ASSERT_EQUAL(0, HeldLockTable::heldCount());
+
+    {
+        RecordedGuard guard(binarySem);
+        // Stand-in for a watchdog reset while the lock is held
+        HeldLockTable::begin();
+    }
+    TEST_ASSERT_EQUAL(1, HeldLockTable::previousCount());
+    TEST_ASSERT_EQUAL_PTR(binarySem, HeldLockTable::previous(0).handle);
+    TEST_ASSERT_NOT_NULL(HeldLockTable::previous(0).caller);
+    TEST_ASSERT_EQUAL(0, HeldLockTable::heldCount());
+}
+
+typedef BasicSemaphoreGuard<DeadlockAwareAcquire, NoTiming, NoStats, SemaphoreLog> WatchedGuard;
+
+static SemaphoreHandle_t deadlockA = nullptr;
+static SemaphoreHandle_t deadlockB = nullptr;
+static volatile int deadlockResult[2];
+
+static void deadlockTask(void* param) {
+    const int id = static_cast<int>(reinterpret_cast<intptr_t>(param));
+    {
+        WatchedGuard first(id == 0 ? deadlockA : deadlockB);
+        vTaskDelay(pdMS_TO_TICKS(20));
+        WatchedGuard second(id == 0 ? deadlockB : deadlockA);
+        deadlockResult[id] = second.hasLock() ? 1 : 2;
+    }
+    vTaskDelete(nullptr);
+}
+
+void test_deadlock_detector_breaks_cycle() {
+    if (deadlockA == nullptr) {
+        deadlockA = xSemaphoreCreateMutex();
+        deadlockB = xSemaphoreCreateMutex();
+    }
+    deadlockResult[0] = 0;
+    deadlockResult[1] = 0;
+
+    // Opposite lock order on purpose; task 0 has the lower priority
+    xTaskCreate(deadlockTask, "dl0", 2048, reinterpret_cast<void*>(0), 2, nullptr);
+    xTaskCreate(deadlockTask, "dl1", 2048, reinterpret_cast<void*>(1), 3, nullptr);
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    // First sighting only marks the cycle; the second confirms it
+    TEST_ASSERT_EQUAL(0, DeadlockDetector::check(true));
+    TEST_ASSERT_EQUAL(1, DeadlockDetector::check(true));
+    vTaskDelay(pdMS_TO_TICKS(50));
+
+    TEST_ASSERT_EQUAL(2, deadlockResult[0]);  // Victim: its wait was aborted
+    TEST_ASSERT_EQUAL(1, deadlockResult[1]);
+    TEST_ASSERT_EQUAL(0, DeadlockDetector::check(true));
+}
+
+typedef BasicSemaphoreGuard<SemaphoreAcquire, NoTiming, SamplingStats, SemaphoreLog> SampledGuard;
+
+void test_sampling_profiler_records_sites() {
+    ContentionProfiler::reset();
+    ContentionProfiler::setPeriod(1);
+    for (int i = 0; i < 3; i++) {
+        SampledGuard guard(binarySem);
+        TEST_ASSERT_TRUE(guard.hasLock());
+    }
+    TEST_ASSERT_EQUAL(3, ContentionProfiler::samples());
+
+    ContentionSite sites[SEMAPHORE_GUARD_PROFILE_SITES];
+    TEST_ASSERT_EQUAL(1, ContentionProfiler::snapshot(sites, SEMAPHORE_GUARD_PROFILE_SITES));
+    TEST_ASSERT_EQUAL(3, sites[0].samples);
+    TEST_ASSERT_EQUAL_PTR(binarySem, sites[0].handle);
+
+    // Switched off: nothing more is recorded
+    ContentionProfiler::setPeriod(0);
+    {
+        SampledGuard guard(binarySem);
+    }
+    TEST_ASSERT_EQUAL(3, ContentionProfiler::samples());
+    ContentionProfiler::setPeriod(SEMAPHORE_GUARD_SAMPLE_PERIOD);
+}
+
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+void test_held_list_tracks_task_locks() {
+    HeldListNode outer;
+    HeldListNode inner;
+    const GuardSite site = {__FILE__, __LINE__, nullptr};
+    HeldList::push(outer, binarySem, site);
+    HeldList::push(inner, countingSem, site);
+    TEST_ASSERT_TRUE(HeldList::holds(binarySem));
+    TEST_ASSERT_TRUE(HeldList::holds(countingSem));
+
+    HeldListEntry entries[4];
+    TEST_ASSERT_EQUAL(2, HeldList::snapshot(nullptr, entries, 4));
+    TEST_ASSERT_EQUAL_PTR(countingSem, entries[0].handle);  // Newest first
+
+    // Out-of-order removal is allowed
+    HeldList::remove(outer);
+    TEST_ASSERT_FALSE(HeldList::holds(binarySem));
+    HeldList::remove(inner);
+    TEST_ASSERT_EQUAL(0, HeldList::snapshot(nullptr, entries, 4));
+}
+
+void test_held_list_detects_self_deadlock() {
+    SemaphoreHandle_t mutex = xSemaphoreCreateMutex();
+    {
+        SemaphoreGuard outer(mutex);
+        TEST_ASSERT_TRUE(outer.hasLock());
+
+        // Would block forever; fails immediately instead
+        SemaphoreGuard inner(mutex);
+        TEST_ASSERT_FALSE(inner.hasLock());
+
+        // A counting semaphore may be taken twice
+        SemaphoreGuard first(countingSem);
+        SemaphoreGuard second(countingSem);
+        TEST_ASSERT_TRUE(second.hasLock());
+    }
+    vSemaphoreDelete(mutex);
+}
+#endif
+
+void test_recursive_guard_nested_release_order() {
+    SemaphoreHandle_t mutex = xSemaphoreCreateRecursiveMutex();
+    RecursiveOwnership::reset();
+    {
+        RecursiveSemaphoreGuard outer(mutex);
+        {
+            RecursiveSemaphoreGuard middle(mutex);
+            RecursiveSemaphoreGuard inner(mutex, (TickType_t)0);
+            TEST_ASSERT_TRUE(inner.hasLock());
+        }
+
+        // Unlocking the outer guard first keeps the mutex for the nested one
+        RecursiveSemaphoreGuard nested(mutex);
+        outer.unlock();
+        TEST_ASSERT_EQUAL_PTR(xTaskGetCurrentTaskHandle(), xSemaphoreGetMutexHolder(mutex));
+    }
+    TEST_ASSERT_NULL(xSemaphoreGetMutexHolder(mutex));
+
+#ifdef SEMAPHORE_GUARD_RECURSIVE_FAST_PATH
+    RecursionStats stats[2];
+    TEST_ASSERT_EQUAL(1, RecursiveOwnership::snapshot(stats, 2));
+    TEST_ASSERT_EQUAL(3, stats[0].maxDepth);
+    TEST_ASSERT_EQUAL(3, stats[0].reentries);
+#endif
+    vSemaphoreDelete(mutex);
+}
+
+static SemaphoreHandle_t batchMutex = nullptr;
+static volatile bool batchWaiterDone = false;
+
+static void batchWaiterTask(void*) {
+    {
+        SemaphoreGuard guard(batchMutex);
+        batchWaiterDone = guard.hasLock();
+    }
+    vTaskDelete(nullptr);
+}
+
+void test_batching_guard_hands_over_lock() {
+    batchMutex = xSemaphoreCreateMutex();
+    batchWaiterDone = false;
+    {
+        BatchingGuard batch(batchMutex, 3, portMAX_DELAY);
+        for (int i = 0; i < 7; i++) {
+            TEST_ASSERT_TRUE(batch.next());
+        }
+        TEST_ASSERT_EQUAL(2, batch.handoffs());  // After operations 3 and 6
+
+        // A blocked guard ends the batch early
+        xTaskCreate(batchWaiterTask, "waiter", 2048, nullptr, uxTaskPriorityGet(nullptr) + 1, nullptr);
+        vTaskDelay(pdMS_TO_TICKS(10));
+        TEST_ASSERT_TRUE(SemaphoreWaiters::any(batchMutex));
+        TEST_ASSERT_TRUE(batch.next());
+        TEST_ASSERT_EQUAL(3, batch.handoffs());
+        TEST_ASSERT_TRUE(batchWaiterDone);
+    }
+    vSemaphoreDelete(batchMutex);
+}
+
+void test_batching_guard_ignores_lower_priority_waiter() {
+    batchMutex = xSemaphoreCreateMutex();
+    batchWaiterDone = false;
+    {
+        BatchingGuard batch(batchMutex, 1000, portMAX_DELAY);
+
+        // Same core, lower priority: it only gets the mutex when this task sleeps
+        xTaskCreatePinnedToCore(batchWaiterTask, "waiter", 2048, nullptr,
+                                uxTaskPriorityGet(nullptr) - 1, nullptr, xPortGetCoreID());
+        vTaskDelay(pdMS_TO_TICKS(10));
+        TEST_ASSERT_TRUE(SemaphoreWaiters::any(batchMutex));
+        for (int i = 0; i < 20; i++) {
+            TEST_ASSERT_TRUE(batch.next());
+        }
+        TEST_ASSERT_EQUAL(1, batch.handoffs());  // Handed over once, not on every operation
+        TEST_ASSERT_TRUE(batchWaiterDone);
+    }
+    {
+        // A waiter that never takes this mutex, like one on another handle
+        // in the same bucket
+        SemaphoreWaiters::enter(batchMutex);
+        BatchingGuard batch(batchMutex, 1000, portMAX_DELAY);
+        for (int i = 0; i < 20; i++) {
+            TEST_ASSERT_TRUE(batch.next());
+        }
+        TEST_ASSERT_EQUAL((20 - 1) / SEMAPHORE_GUARD_BATCH_MIN_OPS, batch.handoffs());
+        SemaphoreWaiters::leave(batchMutex);
+    }
+    vSemaphoreDelete(batchMutex);
+}
+
+void test_semaphore_guard_yields_if_contended() {
+    batchMutex = xSemaphoreCreateMutex();
+    batchWaiterDone = false;
+    {
+        SemaphoreGuard guard(batchMutex);
+        TEST_ASSERT_FALSE(guard.hasWaiters());
+        TEST_ASSERT_TRUE(guard.yieldIfContended());  // Nobody waits: keeps the lock
+        TEST_ASSERT_FALSE(batchWaiterDone);
+
+        xTaskCreate(batchWaiterTask, "waiter", 2048, nullptr, uxTaskPriorityGet(nullptr) + 1, nullptr);
+        vTaskDelay(pdMS_TO_TICKS(10));
+        TEST_ASSERT_TRUE(guard.hasWaiters());
+        TEST_ASSERT_TRUE(guard.yieldIfContended());
+        TEST_ASSERT_TRUE(batchWaiterDone);
+        TEST_ASSERT_FALSE(guard.hasWaiters());
+    }
+    vSemaphoreDelete(batchMutex);
+}
+
+#ifdef SEMAPHORE_GUARD_HAS_COROUTINES
+// Executor drained by the test task itself
+class AsyncTestExecutor : public AsyncExecutor {
+public:
+    AsyncTestExecutor() : m_queue(xQueueCreate(8, sizeof(void*))) {}
+    ~AsyncTestExecutor() { vQueueDelete(m_queue); }
+
+    void post(std::coroutine_handle<> handle) override {
+        void* address = handle.address();
+        xQueueSend(m_queue, &address, portMAX_DELAY);
+    }
+
+    // Resume one queued coroutine; false if none arrived within wait
+    bool runOne(TickType_t wait) {
+        void* address = nullptr;
+        if (xQueueReceive(m_queue, &address, wait) != pdTRUE) {
+            return false;
+        }
+        std::coroutine_handle<>::from_address(address).resume();
+        return true;
+    }
+
+private:
+    QueueHandle_t m_queue;
+};
+
+struct AsyncTestSession {
+    struct promise_type {
+        AsyncTestSession get_return_object() { return {}; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() {}
+    };
+};
+
+static int asyncOrder[4];
+static int asyncOrderCount = 0;
+
+// Records id on success and -id on timeout; the permit is released on return
+static AsyncTestSession asyncAcquire(AsyncSemaphore& sem, int id, TickType_t timeout) {
+    AsyncSemaphore::Guard guard = co_await sem.lockFor(timeout);
+    asyncOrder[asyncOrderCount++] = guard.hasLock() ? id : -id;
+}
+
+void test_async_semaphore_grants_in_fifo_order() {
+    AsyncTestExecutor executor;
+    AsyncSemaphore sem(executor);
+    asyncOrderCount = 0;
+
+    AsyncSemaphore::Guard holder = sem.tryLock();
+    TEST_ASSERT_TRUE(holder.hasLock());
+
+    asyncAcquire(sem, 1, portMAX_DELAY);
+    asyncAcquire(sem, 2, portMAX_DELAY);
+    asyncAcquire(sem, 3, portMAX_DELAY);
+    TEST_ASSERT_EQUAL(0, asyncOrderCount);
+
+    // Each session hands the permit to the next one when it returns
+    holder.unlock();
+    while (executor.runOne(pdMS_TO_TICKS(100))) {
+    }
+
+    TEST_ASSERT_EQUAL(3, asyncOrderCount);
+    TEST_ASSERT_EQUAL(1, asyncOrder[0]);
+    TEST_ASSERT_EQUAL(2, asyncOrder[1]);
+    TEST_ASSERT_EQUAL(3, asyncOrder[2]);
+    TEST_ASSERT_EQUAL(1, sem.available());
+}
+
+void test_async_semaphore_lock_for_times_out() {
+    AsyncTestExecutor executor;
+    AsyncSemaphore sem(executor);
+    asyncOrderCount = 0;
+
+    AsyncSemaphore::Guard holder = sem.tryLock();
+    TEST_ASSERT_TRUE(holder.hasLock());
+
+    asyncAcquire(sem, 1, pdMS_TO_TICKS(20));
+    TEST_ASSERT_EQUAL(0, asyncOrderCount);
+
+    // Resumed by the timer task once the timeout expires
+    TEST_ASSERT_TRUE(executor.runOne(pdMS_TO_TICKS(500)));
+    TEST_ASSERT_EQUAL(1, asyncOrderCount);
+    TEST_ASSERT_EQUAL(-1, asyncOrder[0]);
+    TEST_ASSERT_EQUAL(0, sem.available());
+
+    holder.unlock();
+    TEST_ASSERT_EQUAL(1, sem.available());
+}
+#endif  // SEMAPHORE_GUARD_HAS_COROUTINES
+
 // Test runner
 void runSemaphoreGuardTests() {
     UNITY_BEGIN();
@@ -143,13 +1081,63 @@ void runSemaphoreGuardTests() {
     RUN_TEST(test_semaphore_guard_acquires_binary);
     RUN_TEST(test_semaphore_guard_releases_on_destruction);
     RUN_TEST(test_semaphore_guard_timeout);
+#if SEMAPHORE_GUARD_VALIDATION >= 2
     RUN_TEST(test_semaphore_guard_null_handle);
     RUN_TEST(test_semaphore_guard_is_valid);
+#endif
     RUN_TEST(test_semaphore_guard_get_handle);
     RUN_TEST(test_semaphore_guard_counting_semaphore);
     RUN_TEST(test_semaphore_guard_infinite_wait);
     RUN_TEST(test_semaphore_guard_noexcept);
     RUN_TEST(test_semaphore_guard_signaling_pattern);
+    RUN_TEST(test_semaphore_guard_deadline_acquires_with_budget);
+    RUN_TEST(test_semaphore_guard_deadline_shared_across_guards);
+    RUN_TEST(test_seqlock_read_returns_written_value);
+    RUN_TEST(test_seqlock_try_read_fails_during_write);
+    RUN_TEST(test_rcu_store_reader_keeps_old_version);
+    RUN_TEST(test_rcu_store_update_times_out_when_all_versions_pinned);
+    RUN_TEST(test_isr_semaphore_guard_refuses_task_context);
+    RUN_TEST(test_isr_semaphore_guard_null_handle);
+    RUN_TEST(test_critical_section_guard_acquires_and_releases);
+    RUN_TEST(test_critical_section_guard_null_handle);
+    RUN_TEST(test_flat_combiner_runs_operation);
+    RUN_TEST(test_async_acquire_runs_callback_with_lock);
+    RUN_TEST(test_async_acquire_reports_timeout);
+    RUN_TEST(test_semaphore_arena_creates_usable_handles);
+    RUN_TEST(test_semaphore_arena_full_returns_invalid_handle);
+    RUN_TEST(test_lazy_semaphore_creates_on_first_guard);
+    RUN_TEST(test_lazy_semaphore_recursive_mutex);
+    RUN_TEST(test_typed_handles_select_guard_type);
+    RUN_TEST(test_condition_variable_wakes_waiter);
+    RUN_TEST(test_condition_variable_wait_for_times_out);
+    RUN_TEST(test_condition_variable_ignores_unrelated_give_while_notified);
+    RUN_TEST(test_semaphore_guard_unlock_and_relock);
+    RUN_TEST(test_ticket_lock_grants_in_arrival_order);
+    RUN_TEST(test_ticket_lock_guard_times_out);
+    RUN_TEST(test_mcs_lock_guard_acquires_and_releases);
+    RUN_TEST(test_mcs_lock_abandoned_waiter_is_skipped);
+    RUN_TEST(test_priority_ceiling_guard_raises_and_restores);
+    RUN_TEST(test_priority_ceiling_guard_restores_on_timeout);
+#if configUSE_TRACE_FACILITY
+    RUN_TEST(test_priority_boost_ignores_inherited_priority);
+#endif
+    RUN_TEST(test_ranked_guard_allows_increasing_order);
+    RUN_TEST(test_ranked_guard_rejects_lower_rank);
+    RUN_TEST(test_held_lock_table_records_and_survives_reset);
+    RUN_TEST(test_deadlock_detector_breaks_cycle);
+    RUN_TEST(test_sampling_profiler_records_sites);
+#ifdef SEMAPHORE_GUARD_HELD_LIST
+    RUN_TEST(test_held_list_tracks_task_locks);
+    RUN_TEST(test_held_list_detects_self_deadlock);
+#endif
+    RUN_TEST(test_recursive_guard_nested_release_order);
+    RUN_TEST(test_batching_guard_hands_over_lock);
+    RUN_TEST(test_batching_guard_ignores_lower_priority_waiter);
+    RUN_TEST(test_semaphore_guard_yields_if_contended);
+#ifdef SEMAPHORE_GUARD_HAS_COROUTINES
+    RUN_TEST(test_async_semaphore_grants_in_fifo_order);
+    RUN_TEST(test_async_semaphore_lock_for_times_out);
+#endif
 
     UNITY_END();
 }